@@ -0,0 +1,125 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  BenchmarkUtils.h
+ * @brief Helpers shared by the benchmark executables.
+ */
+
+#pragma once
+
+#include <gtdynamics/universal_robot/Robot.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gtdynamics {
+namespace benchmark {
+
+/// Return all robot description files in models/sdfs and models/urdfs,
+/// excluding the small test models.
+inline std::vector<std::string> ModelFiles() {
+  namespace fs = std::filesystem;
+  std::vector<std::string> files;
+  for (const std::string root : {kSdfPath, kUrdfPath}) {
+    for (auto &&entry : fs::recursive_directory_iterator(root)) {
+      const auto &path = entry.path();
+      const auto extension = path.extension().string();
+      if (extension != ".sdf" && extension != ".urdf") continue;
+      if (path.string().find("/test/") != std::string::npos) continue;
+      files.push_back(path.string());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+/// Load a robot, returning nothing if the file cannot be parsed.
+inline std::optional<Robot> LoadRobot(const std::string &file_path) {
+  try {
+    return CreateRobotFromFile(file_path);
+  } catch (const std::exception &) {
+    return {};
+  }
+}
+
+/// Short name of a model file, e.g., "a1" for ".../a1/a1.urdf".
+inline std::string ModelName(const std::string &file_path) {
+  return std::filesystem::path(file_path).stem().string();
+}
+
+/// Link used as the root for forward kinematics: a fixed link if there is
+/// one, otherwise the first link.
+inline LinkSharedPtr RootLink(const Robot &robot) {
+  const auto links = robot.links();
+  for (auto &&link : links) {
+    if (link->isFixed()) return link;
+  }
+  return links.front();
+}
+
+/**
+ * Kinematics at time t with deterministic non-zero joint angles and
+ * velocities, as well as all link poses and twists.
+ */
+inline gtsam::Values SampleKinematics(const Robot &robot, int t = 0) {
+  gtsam::Values values;
+  const auto root = RootLink(robot);
+  if (!root->isFixed()) {
+    InsertPose(&values, root->id(), t, root->bMcom());
+    InsertTwist(&values, root->id(), t, gtsam::Z_6x1);
+  }
+  for (auto &&joint : robot.joints()) {
+    const int j = joint->id();
+    InsertJointAngle(&values, j, t, 0.1 * std::sin(j));
+    InsertJointVel(&values, j, t, 0.1 * std::cos(j));
+  }
+  return robot.forwardKinematics(values, t, root->name());
+}
+
+/**
+ * Add a damping term lambda * I on every variable, as in one iteration of
+ * Levenberg-Marquardt, so that the underdetermined graphs (no priors) can be
+ * eliminated.
+ */
+inline gtsam::GaussianFactorGraph Damped(
+    const gtsam::GaussianFactorGraph &linear, const gtsam::Values &values,
+    double lambda) {
+  gtsam::GaussianFactorGraph damped = linear;
+  const double sigma = 1.0 / std::sqrt(lambda);
+  for (auto &&key : values.keys()) {
+    const size_t dim = values.at(key).dim();
+    damped.emplace_shared<gtsam::JacobianFactor>(
+        key, gtsam::Matrix::Identity(dim, dim), gtsam::Vector::Zero(dim),
+        gtsam::noiseModel::Isotropic::Sigma(dim, sigma));
+  }
+  return damped;
+}
+
+/// Run `function` repeatedly and return the mean wall time in microseconds.
+template <typename FUNCTION>
+double MeanMicroseconds(FUNCTION &&function, size_t iterations) {
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  for (size_t i = 0; i < iterations; ++i) function();
+  const std::chrono::duration<double, std::micro> elapsed =
+      Clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+}  // namespace benchmark
+}  // namespace gtdynamics
@@ -0,0 +1,171 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  bench_fixed_lag_smoother.cpp
+ * @brief Replay a spider trajectory through the fixed-lag smoother, and report
+ * the latency of every update against the real-time budget.
+ *
+ * Usage: bench_fixed_lag_smoother [trajectory.csv] [lag]
+ *
+ * The trajectory file has the layout written by Trajectory::writeToFile, e.g.,
+ * by the spider walking example: joint angles in the first columns and time in
+ * the last. Without a file, a synthetic gait of 10 seconds at 100 Hz is used.
+ * Feet are in contact when their tip is within 1 cm of the lowest foot tip.
+ */
+
+#include <gtdynamics/kinematics/KinematicsFixedLagSmoother.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace gtdynamics;
+using gtsam::Pose3;
+
+namespace {
+/// One time step of a recorded trajectory.
+struct Sample {
+  std::map<std::string, double> joint_angles;
+  double dt;
+};
+
+/// Read joint angles and time steps from a Trajectory::writeToFile file.
+std::vector<Sample> ReadTrajectory(const Robot &robot,
+                                   const std::string &file_path) {
+  std::ifstream file(file_path);
+  if (!file) throw std::runtime_error("Cannot open " + file_path);
+  std::string line;
+  std::getline(file, line);
+  const size_t num_joints = robot.numJoints();
+  std::vector<std::string> names;
+  std::stringstream header(line);
+  for (std::string name; names.size() < num_joints &&
+                         std::getline(header, name, ',');) {
+    names.push_back(name);
+  }
+
+  std::vector<Sample> samples;
+  double t_prev = 0, dt = 0.01;
+  while (std::getline(file, line)) {
+    std::vector<double> row;
+    std::stringstream ss(line);
+    for (std::string cell; std::getline(ss, cell, ',');) {
+      row.push_back(std::stod(cell));
+    }
+    if (row.size() < num_joints + 1) continue;
+    // Time restarts in every phase, so keep the last positive time step.
+    if (row.back() > t_prev) dt = row.back() - t_prev;
+    t_prev = row.back();
+    Sample sample{{}, dt};
+    for (size_t j = 0; j < num_joints; j++) {
+      sample.joint_angles[names[j]] = row[j];
+    }
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+/// Synthetic gait: every joint oscillates at 1 Hz, legs alternate in phase.
+std::vector<Sample> SyntheticTrajectory(const Robot &robot) {
+  const double dt = 0.01;
+  std::vector<Sample> samples(1000);
+  for (size_t k = 0; k < samples.size(); k++) {
+    samples[k].dt = dt;
+    for (auto &&joint : robot.joints()) {
+      samples[k].joint_angles[joint->name()] =
+          0.2 * std::sin(2 * M_PI * k * dt + M_PI * (joint->id() % 2));
+    }
+  }
+  return samples;
+}
+
+/// Foot tips within 1 cm of the lowest foot tip, in the base frame.
+PointOnLinks Contacts(const Robot &robot, const Sample &sample,
+                      const PointOnLinks &feet) {
+  gtsam::Values known;
+  InsertPose(&known, robot.link("body")->id(), 0, Pose3());
+  for (auto &&joint : robot.joints()) {
+    InsertJointAngle(&known, joint->id(), 0,
+                     sample.joint_angles.at(joint->name()));
+  }
+  const gtsam::Values fk = robot.forwardKinematics(known, 0, "body");
+  double lowest = 1e9;
+  for (auto &&foot : feet) lowest = std::min(lowest, foot.predict(fk).z());
+  PointOnLinks contacts;
+  for (auto &&foot : feet) {
+    if (foot.predict(fk).z() < lowest + 0.01) contacts.push_back(foot);
+  }
+  return contacts;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  const Robot robot =
+      CreateRobotFromFile(kSdfPath + std::string("spider.sdf"), "spider");
+  const std::vector<Sample> samples =
+      argc > 1 ? ReadTrajectory(robot, argv[1]) : SyntheticTrajectory(robot);
+  const size_t lag = argc > 2 ? std::stoul(argv[2]) : 20;
+  if (samples.empty()) {
+    std::fprintf(stderr, "No samples to replay.\n");
+    return 1;
+  }
+
+  // Tip of every tarsus, as in the spider walking example.
+  PointOnLinks feet;
+  for (auto &&link : robot.links()) {
+    if (link->name().find("tarsus") == 0) {
+      feet.emplace_back(link, gtsam::Point3(0, 0.19, 0));
+    }
+  }
+
+  KinematicsFixedLagSmoother smoother(
+      robot, "body", Pose3(gtsam::Rot3(), gtsam::Point3(0, 0, 0.5)),
+      KinematicsFixedLagSmootherParameters(lag, std::max<size_t>(lag / 4, 1)));
+
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> latencies_us;
+  size_t deadline_misses = 0;
+  double duration = 0;
+  for (auto &&sample : samples) {
+    const auto contacts = Contacts(robot, sample, feet);
+    const auto start = Clock::now();
+    smoother.update(sample.joint_angles, contacts, sample.dt);
+    const double us =
+        std::chrono::duration<double, std::micro>(Clock::now() - start)
+            .count();
+    latencies_us.push_back(us);
+    if (us > sample.dt * 1e6) deadline_misses++;
+    duration += sample.dt;
+  }
+
+  double total_us = 0;
+  for (double us : latencies_us) total_us += us;
+  std::vector<double> sorted = latencies_us;
+  std::sort(sorted.begin(), sorted.end());
+  const auto percentile = [&](double p) {
+    return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))];
+  };
+
+  std::printf("%zu steps over %.2f s, lag %zu, %zu variables in window\n",
+              samples.size(), duration, lag, smoother.estimate().size());
+  std::printf("latency [us]: mean %.1f, p50 %.1f, p99 %.1f, max %.1f\n",
+              total_us / samples.size(), percentile(0.5), percentile(0.99),
+              sorted.back());
+  std::printf("real-time factor %.2f, %zu deadline misses\n",
+              duration * 1e6 / total_us, deadline_misses);
+  return 0;
+}
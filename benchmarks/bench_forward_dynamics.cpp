@@ -0,0 +1,57 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  bench_forward_dynamics.cpp
+ * @brief Compare factor-graph and articulated-body forward dynamics.
+ */
+
+#include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/dynamics/RecursiveDynamics.h>
+
+#include <cstdio>
+
+#include "BenchmarkUtils.h"
+
+using namespace gtdynamics;
+using namespace gtdynamics::benchmark;
+
+int main(int argc, char** argv) {
+  const size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000;
+  const gtsam::Vector3 gravity(0, 0, -9.8);
+  DynamicsGraph graph_builder(gravity);
+  RecursiveDynamics recursive_dynamics(gravity);
+
+  std::printf("%-24s %6s %6s %14s %14s %8s\n", "model", "links", "joints",
+              "graph [us]", "aba [us]", "speedup");
+  for (auto&& file : ModelFiles()) {
+    auto robot = LoadRobot(file);
+    if (!robot || !RecursiveDynamics::IsTree(*robot)) continue;
+
+    gtsam::Values known_values;
+    try {
+      known_values = SampleKinematics(*robot);
+    } catch (const std::exception&) {
+      continue;
+    }
+    for (auto&& joint : robot->joints()) {
+      InsertTorque(&known_values, joint->id(), 0, 0.1);
+    }
+
+    const double graph_us = MeanMicroseconds(
+        [&] { graph_builder.linearSolveFD(*robot, 0, known_values); },
+        iterations);
+    const double aba_us = MeanMicroseconds(
+        [&] { recursive_dynamics.solveFD(*robot, 0, known_values); },
+        iterations);
+
+    std::printf("%-24s %6d %6d %14.2f %14.2f %8.1f\n", ModelName(file).c_str(),
+                robot->numLinks(), robot->numJoints(), graph_us, aba_us,
+                graph_us / aba_us);
+  }
+  return 0;
+}
@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  bench_joint_factors.cpp
+ * @brief Compare linearization cost of expression-based and joint-typed joint
+ * factors.
+ */
+
+#include <gtdynamics/factors/PoseFactor.h>
+#include <gtdynamics/factors/TorqueFactor.h>
+#include <gtdynamics/factors/TwistAccelFactor.h>
+#include <gtdynamics/factors/TwistFactor.h>
+#include <gtdynamics/factors/WrenchEquivalenceFactor.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+
+using namespace gtdynamics;
+using namespace gtdynamics::benchmark;
+using gtsam::NonlinearFactorGraph;
+
+namespace {
+struct FactorKind {
+  std::string name;
+  // Factor with the joint constraint expression.
+  std::function<gtsam::NonlinearFactor::shared_ptr(const JointConstSharedPtr &)>
+      expression;
+  // Factor returned by the factory, specialized on the joint type.
+  std::function<gtsam::NonlinearFactor::shared_ptr(const JointConstSharedPtr &)>
+      typed;
+};
+
+template <typename T>
+gtsam::NonlinearFactor::shared_ptr Expression(
+    const gtsam::Expression<T> &expression, size_t dim) {
+  return std::make_shared<gtsam::ExpressionFactor<T>>(
+      gtsam::noiseModel::Unit::Create(dim), gtsam::traits<T>::Identity(),
+      expression);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000;
+  const std::string file =
+      argc > 2 ? argv[2] : kUrdfPath + std::string("a1/a1.urdf");
+  const Robot robot = CreateRobotFromFile(file);
+  const auto model6 = gtsam::noiseModel::Unit::Create(6);
+  const auto model1 = gtsam::noiseModel::Unit::Create(1);
+
+  // Linearization point with all joint factor variables at time 0.
+  gtsam::Values values = SampleKinematics(robot);
+  for (auto &&link : robot.links()) {
+    if (!values.exists(TwistAccelKey(link->id(), 0))) {
+      InsertTwistAccel(&values, link->id(), 0, gtsam::Vector6::Constant(0.1));
+    }
+  }
+  for (auto &&joint : robot.joints()) {
+    const int j = joint->id();
+    InsertJointAccel(&values, j, 0, 0.2);
+    InsertTorque(&values, j, 0, 0.3);
+    for (auto &&link : joint->links()) {
+      InsertWrench(&values, link->id(), j, 0, gtsam::Vector6::Constant(0.4));
+    }
+  }
+
+  const std::vector<FactorKind> kinds{
+      {"pose",
+       [](auto &&joint) { return Expression(joint->poseConstraint(), 6); },
+       [&](auto &&joint) { return PoseFactor(model6, joint, 0); }},
+      {"twist",
+       [](auto &&joint) { return Expression(joint->twistConstraint(), 6); },
+       [&](auto &&joint) { return TwistFactor(model6, joint, 0); }},
+      {"twist_accel",
+       [](auto &&joint) {
+         return Expression(joint->twistAccelConstraint(), 6);
+       },
+       [&](auto &&joint) { return TwistAccelFactor(model6, joint, 0); }},
+      {"wrench_equivalence",
+       [](auto &&joint) {
+         return Expression(joint->wrenchEquivalenceConstraint(), 6);
+       },
+       [&](auto &&joint) { return WrenchEquivalenceFactor(model6, joint, 0); }},
+      {"torque",
+       [](auto &&joint) { return Expression(joint->torqueConstraint(), 1); },
+       [&](auto &&joint) { return TorqueFactor(model1, joint, 0); }},
+  };
+
+  std::printf("%s: %d joints, %zu iterations\n", ModelName(file).c_str(),
+              robot.numJoints(), iterations);
+  std::printf("%-20s %16s %16s %8s\n", "factor", "expression [us]",
+              "typed [us]", "speedup");
+  for (auto &&kind : kinds) {
+    NonlinearFactorGraph expression_graph, typed_graph;
+    for (auto &&joint : robot.joints()) {
+      expression_graph.push_back(kind.expression(joint));
+      typed_graph.push_back(kind.typed(joint));
+    }
+    const double n = robot.numJoints();
+    const double expression_us =
+        MeanMicroseconds([&] { expression_graph.linearize(values); },
+                         iterations) /
+        n;
+    const double typed_us =
+        MeanMicroseconds([&] { typed_graph.linearize(values); }, iterations) /
+        n;
+    std::printf("%-20s %16.3f %16.3f %8.1f\n", kind.name.c_str(),
+                expression_us, typed_us, expression_us / typed_us);
+  }
+  return 0;
+}
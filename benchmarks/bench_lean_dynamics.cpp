@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  bench_lean_dynamics.cpp
+ * @brief Compare the full trajectory graph of a quadruped with the lean graph,
+ * in which every leg is a massless chain.
+ *
+ * Usage: bench_lean_dynamics [repetitions] [num_steps]
+ *
+ * Both graphs have all four feet in contact. For each, the number of factors
+ * and variables is reported, as well as the time to build, linearize and
+ * eliminate the graph.
+ */
+
+#include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/dynamics/LeanDynamicsGraph.h>
+#include <gtdynamics/utils/Initializer.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+
+using namespace gtdynamics;
+using namespace gtdynamics::benchmark;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+namespace {
+struct Quadruped {
+  std::string file, body;
+};
+
+/// Time building, linearizing and eliminating one graph, and print a row.
+void Run(const std::string &name,
+         const std::function<NonlinearFactorGraph()> &build,
+         const Values &values, size_t repetitions) {
+  NonlinearFactorGraph graph;
+  const double build_us =
+      MeanMicroseconds([&] { graph = build(); }, repetitions);
+
+  // Restrict the values to the variables of the graph.
+  Values graph_values;
+  for (auto &&key : graph.keys()) graph_values.insert(key, values.at(key));
+
+  gtsam::GaussianFactorGraph::shared_ptr linear;
+  const double linearize_us = MeanMicroseconds(
+      [&] { linear = graph.linearize(graph_values); }, repetitions);
+  const auto damped = Damped(*linear, graph_values, 1e-5);
+  const double eliminate_us = MeanMicroseconds(
+      [&] { damped.eliminateMultifrontal(); }, repetitions);
+
+  std::printf("%-8s %10zu %10zu %12.0f %12.0f %12.0f\n", name.c_str(),
+              graph.size(), graph_values.size(), build_us, linearize_us,
+              eliminate_us);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t repetitions = argc > 1 ? std::stoul(argv[1]) : 10;
+  const int num_steps = argc > 2 ? std::stoi(argv[2]) : 20;
+  const double dt = 0.01;
+  const gtsam::Vector3 gravity(0, 0, -9.8);
+
+  const std::vector<Quadruped> quadrupeds{
+      {kUrdfPath + std::string("a1/a1.urdf"), "trunk"},
+      {kUrdfPath + std::string("vision60.urdf"), "body"}};
+
+  for (auto &&quadruped : quadrupeds) {
+    const Robot robot = CreateRobotFromFile(quadruped.file);
+    const LeanDynamicsGraph lean(robot, quadruped.body, gravity);
+
+    PointOnLinks contact_points;
+    for (auto &&leg : lean.legs()) {
+      contact_points.emplace_back(leg.foot, gtsam::Point3(0, 0, 0));
+    }
+    const Values values = Initializer().ZeroValuesTrajectory(
+        robot, num_steps, -1, 0.0, contact_points);
+
+    std::printf("%s: %d links, %d joints, %d steps, %zu repetitions\n",
+                ModelName(quadruped.file).c_str(), robot.numLinks(),
+                robot.numJoints(), num_steps, repetitions);
+    std::printf("%-8s %10s %10s %12s %12s %12s\n", "graph", "factors",
+                "variables", "build [us]", "linear [us]", "elim [us]");
+
+    const DynamicsGraph graph_builder(gravity);
+    Run("full",
+        [&] {
+          return graph_builder.trajectoryFG(robot, num_steps, dt, Trapezoidal,
+                                            contact_points);
+        },
+        values, repetitions);
+    Run("lean",
+        [&] {
+          return lean.trajectoryFG(num_steps, dt, Trapezoidal, contact_points);
+        },
+        values, repetitions);
+  }
+  return 0;
+}
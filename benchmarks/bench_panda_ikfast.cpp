@@ -0,0 +1,78 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  bench_panda_ikfast.cpp
+ * @brief Throughput of batched Panda IKFast against the scalar call.
+ *
+ * Usage: bench_panda_ikfast [num_poses] [num_threads]
+ *
+ * Only built with GTDYNAMICS_BUILD_PANDA_ROBOT.
+ */
+
+#include <gtdynamics/pandarobot/ikfast/PandaIKFast.h>
+#include <gtdynamics/utils/Parallel.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+
+using namespace gtdynamics;
+using namespace gtdynamics::benchmark;
+
+int main(int argc, char **argv) {
+  const size_t num_poses = argc > 1 ? std::stoul(argv[1]) : 20000;
+  const size_t num_threads = NumThreads(argc > 2 ? std::stoul(argv[2]) : 0);
+  constexpr size_t kMax = PandaIKFast::kMaxSolutions;
+  constexpr size_t kJoints = PandaIKFast::kNumJoints;
+
+  // Candidate poses from deterministic joint configurations.
+  std::vector<gtsam::Pose3> poses(num_poses);
+  std::vector<double> theta7(num_poses);
+  for (size_t i = 0; i < num_poses; i++) {
+    gtsam::Vector7 q;
+    for (size_t j = 0; j < kJoints; j++) q(j) = std::sin(0.37 * i + 1.3 * j);
+    q(3) = -1.0 - std::abs(q(3));
+    poses[i] = PandaIKFast::forward(q);
+    theta7[i] = q(6);
+  }
+  std::vector<double> solutions(num_poses * kMax * kJoints);
+  std::vector<uint8_t> valid(num_poses * kMax);
+
+  size_t num_solutions = 0;
+  const double scalar_us = MeanMicroseconds(
+      [&] {
+        num_solutions = 0;
+        for (size_t i = 0; i < num_poses; i++) {
+          num_solutions += PandaIKFast::inverse(poses[i], theta7[i]).size();
+        }
+      },
+      1);
+  const auto batch = [&](size_t threads) {
+    return MeanMicroseconds(
+        [&] {
+          PandaIKFast::inverseBatch(poses.data(), theta7.data(), num_poses,
+                                    solutions.data(), valid.data(), threads);
+        },
+        1);
+  };
+  const double batch1_us = batch(1), batchN_us = batch(num_threads);
+
+  std::printf("%zu poses, %zu solutions\n", num_poses, num_solutions);
+  std::printf("%-24s %14s %12s\n", "", "poses / s", "speedup");
+  const auto report = [&](const std::string &name, double us) {
+    std::printf("%-24s %14.0f %12.2f\n", name.c_str(), num_poses / us * 1e6,
+                scalar_us / us);
+  };
+  report("scalar", scalar_us);
+  report("batch, 1 thread", batch1_us);
+  report("batch, " + std::to_string(num_threads) + " threads", batchN_us);
+  return 0;
+}
@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  bench_slice_template.cpp
+ * @brief Compare dynamics graphs built for every time step with graphs
+ * instantiated from a SliceTemplate.
+ *
+ * Usage: bench_slice_template [iterations] [model file]
+ *
+ * For an increasing horizon, the dynamics factor graph is built by calling
+ * DynamicsGraph::dynamicsFactorGraph for every time step, and by
+ * instantiating a SliceTemplate of time step 0. Both the time to create the
+ * graph and the time to linearize it are reported, so that the overhead of
+ * the RemappedFactor wrappers in the templated graph shows up.
+ */
+
+#include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/utils/Initializer.h>
+#include <gtdynamics/utils/SliceTemplate.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <cstdio>
+#include <string>
+
+#include "BenchmarkUtils.h"
+
+using namespace gtdynamics;
+using namespace gtdynamics::benchmark;
+using gtsam::NonlinearFactorGraph;
+
+int main(int argc, char **argv) {
+  const size_t iterations = argc > 1 ? std::stoul(argv[1]) : 20;
+  const std::string file =
+      argc > 2 ? argv[2] : kSdfPath + std::string("spider.sdf");
+  const Robot robot = CreateRobotFromFile(file);
+  const DynamicsGraph graph_builder(gtsam::Vector3(0, 0, -9.8));
+  const SliceTemplate slice_template(
+      graph_builder.dynamicsFactorGraph(robot, 0), Slice(0));
+
+  std::printf("%s: %zu iterations\n", ModelName(file).c_str(), iterations);
+  std::printf("%8s %8s %14s %14s %14s %14s %8s\n", "steps", "factors",
+              "build [us]", "template [us]", "lin build", "lin template",
+              "ratio");
+  for (size_t num_steps : {10, 100, 1000}) {
+    const Interval interval(0, num_steps - 1);
+    gtsam::Values values;
+    for (size_t k = 0; k < num_steps; k++) {
+      values.insert(Initializer().ZeroValues(robot, k, 0.1));
+    }
+
+    NonlinearFactorGraph built, templated;
+    const double build_us = MeanMicroseconds(
+        [&] {
+          built = NonlinearFactorGraph();
+          for (size_t k = 0; k < num_steps; k++) {
+            built.add(graph_builder.dynamicsFactorGraph(robot, k));
+          }
+        },
+        iterations);
+    const double template_us = MeanMicroseconds(
+        [&] { templated = slice_template.instantiate(interval); },
+        iterations);
+
+    const double linearize_built_us =
+        MeanMicroseconds([&] { built.linearize(values); }, iterations);
+    const double linearize_templated_us =
+        MeanMicroseconds([&] { templated.linearize(values); }, iterations);
+
+    std::printf("%8zu %8zu %14.1f %14.1f %14.1f %14.1f %8.2f\n", num_steps,
+                built.size(), build_us, template_us, linearize_built_us,
+                linearize_templated_us,
+                linearize_templated_us / linearize_built_us);
+  }
+  return 0;
+}
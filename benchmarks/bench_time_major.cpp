@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  bench_time_major.cpp
+ * @brief Compare linear solvers on the Gauss-Newton step of long-horizon
+ * walking trajectories.
+ *
+ * Usage: bench_time_major [repetitions]
+ *
+ * The spider walks for an increasing number of walk cycles, each of 6 time
+ * steps. The multi-phase trajectory graph is linearized at the initial values
+ * and damped as in Levenberg-Marquardt, and solved with
+ *  - colamd:     multifrontal elimination with COLAMD ordering,
+ *  - time-major: multifrontal elimination with TimeMajorOrdering,
+ *  - nested:     multifrontal elimination with the nested-dissection ordering
+ *                over the phases of the trajectory,
+ *  - riccati:    TimeMajorSolve, one time step at a time.
+ * The times include computing the ordering. The largest difference to the
+ * COLAMD solution is reported as a check.
+ */
+
+#include <gtdynamics/optimizer/TimeMajorSolver.h>
+#include <gtdynamics/utils/Initializer.h>
+#include <gtdynamics/utils/Trajectory.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+
+using namespace gtdynamics;
+using namespace gtdynamics::benchmark;
+using gtsam::VectorValues;
+
+namespace {
+/// Walk cycle of the spider, alternating between its two sets of feet.
+WalkCycle SpiderWalkCycle(const Robot &robot) {
+  std::vector<LinkSharedPtr> odd_feet, even_feet;
+  for (const std::string name : {"tarsus_1_L1", "tarsus_3_L3", "tarsus_5_R4",
+                                 "tarsus_7_R2"}) {
+    odd_feet.push_back(robot.link(name));
+  }
+  for (const std::string name : {"tarsus_2_L2", "tarsus_4_L4", "tarsus_6_R3",
+                                 "tarsus_8_R1"}) {
+    even_feet.push_back(robot.link(name));
+  }
+  auto all_feet = odd_feet;
+  all_feet.insert(all_feet.end(), even_feet.begin(), even_feet.end());
+
+  const gtsam::Point3 contact_in_com(0, 0.19, 0);
+  auto stationary =
+      std::make_shared<FootContactConstraintSpec>(all_feet, contact_in_com);
+  auto odd =
+      std::make_shared<FootContactConstraintSpec>(odd_feet, contact_in_com);
+  auto even =
+      std::make_shared<FootContactConstraintSpec>(even_feet, contact_in_com);
+  const FootContactVector states = {stationary, even, stationary, odd};
+  return WalkCycle(states, {1, 2, 1, 2});
+}
+
+/// Largest absolute difference between two solutions.
+double MaxDifference(const VectorValues &a, const VectorValues &b) {
+  return (a - b).vector().lpNorm<Eigen::Infinity>();
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t repetitions = argc > 1 ? std::stoul(argv[1]) : 3;
+  const Robot robot =
+      CreateRobotFromFile(kSdfPath + std::string("spider_alt.sdf"), "spider");
+  const DynamicsGraph graph_builder(OptimizerSetting(1e-5),
+                                    gtsam::Vector3(0, 0, -9.8));
+  const WalkCycle walk_cycle = SpiderWalkCycle(robot);
+
+  std::printf("spider: %d links, %d joints, %zu repetitions\n",
+              robot.numLinks(), robot.numJoints(), repetitions);
+  std::printf("%6s %6s %10s %12s %12s %12s %12s %10s\n", "cycles", "steps",
+              "variables", "colamd [us]", "time [us]", "nested [us]",
+              "riccati [us]", "max diff");
+
+  for (size_t cycles : {2, 8, 32}) {
+    const Trajectory trajectory(walk_cycle, cycles);
+    const auto graph = trajectory.multiPhaseFactorGraph(
+        robot, graph_builder, CollocationScheme::Euler, 1.0);
+    const gtsam::Values values = trajectory.multiPhaseInitialValues(
+        robot, Initializer(), 0.0, 1. / 240);
+    const auto damped = Damped(*graph.linearize(values), values, 1e-5);
+
+    VectorValues colamd, time_major, nested, riccati;
+    const double colamd_us =
+        MeanMicroseconds([&] { colamd = damped.optimize(); }, repetitions);
+    const double time_major_us = MeanMicroseconds(
+        [&] { time_major = damped.optimize(TimeMajorOrdering(damped)); },
+        repetitions);
+    const double nested_us = MeanMicroseconds(
+        [&] {
+          nested =
+              damped.optimize(trajectory.nestedDissectionOrdering(graph));
+        },
+        repetitions);
+    const double riccati_us = MeanMicroseconds(
+        [&] { riccati = TimeMajorSolve(damped); }, repetitions);
+
+    const int num_steps =
+        trajectory.getEndTimeStep(trajectory.numPhases() - 1);
+    std::printf("%6zu %6d %10zu %12.0f %12.0f %12.0f %12.0f %10.2e\n",
+                cycles, num_steps, values.size(), colamd_us, time_major_us,
+                nested_us, riccati_us,
+                std::max({MaxDifference(colamd, time_major),
+                          MaxDifference(colamd, nested),
+                          MaxDifference(colamd, riccati)}));
+  }
+  return 0;
+}
@@ -0,0 +1,249 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  gtdynamics_bench.cpp
+ * @brief Time graph construction, linearization, elimination and LM over the
+ * shipped robot models, and write the results as JSON.
+ *
+ * Usage: gtdynamics_bench [repetitions] [output.json]
+ *
+ * For every model in models/sdfs and models/urdfs, and for several horizons,
+ * three graphs are benchmarked: the per-step dynamics graphs, the trajectory
+ * graph with collocation, and the kinematics graph. The output follows the
+ * layout of Google Benchmark's JSON reporter, with one entry per model, graph,
+ * horizon and stage, so it can be compared across releases with the same
+ * tooling.
+ */
+
+#include <gtdynamics/config.h>
+#include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/kinematics/Kinematics.h>
+#include <gtdynamics/utils/Initializer.h>
+#include <gtdynamics/utils/Interval.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+
+using namespace gtdynamics;
+using namespace gtdynamics::benchmark;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+namespace {
+
+/// One benchmark result, i.e., one entry in the JSON output.
+struct Result {
+  std::string model, graph, stage;
+  int horizon;
+  size_t iterations, num_factors, num_variables;
+  double real_time_us;
+  std::string error;
+};
+
+/// Escape a string for JSON.
+std::string Quote(const std::string &s) {
+  std::string quoted = "\"";
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        quoted += "\\\"";
+        break;
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\b':
+        quoted += "\\b";
+        break;
+      case '\f':
+        quoted += "\\f";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\r':
+        quoted += "\\r";
+        break;
+      case '\t':
+        quoted += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                        static_cast<unsigned char>(c));
+          quoted += escaped;
+        } else {
+          quoted += c;
+        }
+    }
+  }
+  return quoted + "\"";
+}
+
+void WriteJson(const std::vector<Result> &results, std::ostream &os) {
+  const std::time_t now = std::time(nullptr);
+  char date[32];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  os << "{\n  \"context\": {\n"
+     << "    \"date\": " << Quote(date) << ",\n"
+     << "    \"library_version\": " << Quote(GTDYNAMICS_VERSION_STRING)
+     << ",\n"
+     << "    \"num_cpus\": " << std::thread::hardware_concurrency() << "\n"
+     << "  },\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &r = results[i];
+    os << (i ? "," : "") << "\n    {\n"
+       << "      \"name\": "
+       << Quote(r.model + "/" + r.graph + "/" + std::to_string(r.horizon) +
+                "/" + r.stage)
+       << ",\n"
+       << "      \"model\": " << Quote(r.model) << ",\n"
+       << "      \"graph\": " << Quote(r.graph) << ",\n"
+       << "      \"horizon\": " << r.horizon << ",\n"
+       << "      \"stage\": " << Quote(r.stage) << ",\n"
+       << "      \"num_factors\": " << r.num_factors << ",\n"
+       << "      \"num_variables\": " << r.num_variables << ",\n";
+    if (r.error.empty()) {
+      os << "      \"iterations\": " << r.iterations << ",\n"
+         << "      \"real_time\": " << r.real_time_us << ",\n"
+         << "      \"time_unit\": \"us\"\n";
+    } else {
+      os << "      \"error_occurred\": true,\n"
+         << "      \"error_message\": " << Quote(r.error) << "\n";
+    }
+    os << "    }";
+  }
+  os << "\n  ]\n}\n";
+}
+
+/// A graph to benchmark, and how to build it.
+struct GraphCase {
+  std::string name;
+  std::function<NonlinearFactorGraph()> build;
+};
+
+/// Run all stages for one graph, appending to results.
+void RunStages(const std::string &model, const GraphCase &graph_case,
+               int horizon, const Values &values, size_t repetitions,
+               std::vector<Result> *results) {
+  Result result{model, graph_case.name, "", horizon, repetitions, 0, 0, 0, ""};
+  auto run = [&](const std::string &stage, const std::function<void()> &f) {
+    result.stage = stage;
+    result.error.clear();
+    try {
+      result.real_time_us = MeanMicroseconds(f, repetitions);
+    } catch (const std::exception &e) {
+      result.error = e.what();
+    }
+    results->push_back(result);
+    return result.error.empty();
+  };
+
+  NonlinearFactorGraph graph;
+  if (!run("construct", [&] { graph = graph_case.build(); })) return;
+
+  // Restrict the values to the variables of the graph.
+  Values graph_values;
+  for (auto &&key : graph.keys()) {
+    if (values.exists(key)) graph_values.insert(key, values.at(key));
+  }
+  result.num_factors = graph.size();
+  result.num_variables = graph_values.size();
+  if (graph_values.size() != graph.keys().size()) {
+    result.stage = "linearize";
+    result.error = "missing initial values";
+    results->push_back(result);
+    return;
+  }
+  results->back().num_factors = result.num_factors;
+  results->back().num_variables = result.num_variables;
+
+  gtsam::GaussianFactorGraph::shared_ptr linear;
+  if (!run("linearize", [&] { linear = graph.linearize(graph_values); })) {
+    return;
+  }
+
+  const auto damped = Damped(*linear, graph_values, 1e-5);
+  run("eliminate", [&] { damped.eliminateMultifrontal(); });
+
+  gtsam::LevenbergMarquardtParams params;
+  params.setMaxIterations(20);
+  run("lm", [&] {
+    gtsam::LevenbergMarquardtOptimizer(graph, graph_values, params).optimize();
+  });
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t repetitions = argc > 1 ? std::stoul(argv[1]) : 3;
+  const std::string output = argc > 2 ? argv[2] : "";
+  const std::vector<int> horizons{1, 5, 20};
+  const double dt = 0.01;
+  const gtsam::Vector3 gravity(0, 0, -9.8);
+
+  DynamicsGraph graph_builder(gravity);
+  Kinematics kinematics;
+  Initializer initializer;
+
+  std::vector<Result> results;
+  for (auto &&file : ModelFiles()) {
+    auto robot = LoadRobot(file);
+    if (!robot) continue;
+    const std::string model = ModelName(file);
+    std::cerr << model << std::endl;
+
+    for (int horizon : horizons) {
+      Values values;
+      try {
+        values = initializer.ZeroValuesTrajectory(*robot, horizon);
+      } catch (const std::exception &) {
+        continue;
+      }
+
+      const std::vector<GraphCase> cases{
+          {"dynamics",
+           [&] {
+             NonlinearFactorGraph graph;
+             for (int t = 0; t <= horizon; t++) {
+               graph.add(graph_builder.dynamicsFactorGraph(*robot, t));
+             }
+             return graph;
+           }},
+          {"trajectory",
+           [&] { return graph_builder.trajectoryFG(*robot, horizon, dt); }},
+          {"kinematics",
+           [&] { return kinematics.graph(Interval(0, horizon), *robot); }},
+      };
+      for (auto &&graph_case : cases) {
+        RunStages(model, graph_case, horizon, values, repetitions, &results);
+      }
+    }
+  }
+
+  if (output.empty()) {
+    WriteJson(results, std::cout);
+  } else {
+    std::ofstream os(output);
+    WriteJson(results, os);
+  }
+  return 0;
+}
@@ -12,6 +12,7 @@
  */
 
 #include <gtdynamics/dynamics/Chain.h>
+#include <gtdynamics/dynamics/FixedChain.h>
 
 namespace gtdynamics {
 
@@ -86,112 +87,20 @@ Pose3 Chain::poe(const Vector &q, std::optional<Pose3> fTe,
   return poe;
 }
 
-/**
- * Calculate AdjointMap jacobian w.r.t. joint coordinate q
- * @param q joint angle
- * @param jMi this COM frame, expressed in next link's COM frame at rest
- * @param screw_axis screw axis expressed in kth link's COM frame
- *
- * TODO(Varun) Perhaps move part of this to gtsam::Pose3::AdjointMap()?
- */
-gtsam::Matrix6 AdjointMapJacobianQ(double q, const gtsam::Pose3 &jMi,
-                                   const gtsam::Vector6 &screw_axis) {
-  // taking opposite value of screw_axis_ is because
-  // jTi = Pose3::Expmap(-screw_axis_ * q) * jMi;
-  gtsam::Vector3 w = -screw_axis.head<3>();
-  gtsam::Vector3 v = -screw_axis.tail<3>();
-  gtsam::Pose3 kTj = gtsam::Pose3::Expmap(-screw_axis * q) * jMi;
-  auto w_skew = gtsam::skewSymmetric(w);
-  gtsam::Matrix3 H_expo = w_skew * cosf(q) + w_skew * w_skew * sinf(q);
-  gtsam::Matrix3 H_R = H_expo * jMi.rotation().matrix();
-  gtsam::Vector3 H_T =
-      H_expo * (jMi.translation() - w_skew * v) + w * w.transpose() * v;
-  gtsam::Matrix3 H_TR = gtsam::skewSymmetric(H_T) * kTj.rotation().matrix() +
-                        gtsam::skewSymmetric(kTj.translation()) * H_R;
-  gtsam::Matrix6 H = gtsam::Z_6x6;
-  gtsam::insertSub(H, H_R, 0, 0);
-  gtsam::insertSub(H, H_TR, 3, 0);
-  gtsam::insertSub(H, H_R, 3, 3);
-  return H;
-}
-
 gtsam::Vector3 Chain::DynamicalEquality3(
     const gtsam::Vector6 &wrench, const gtsam::Vector3 &angles,
     const gtsam::Vector3 &torques, gtsam::OptionalJacobian<3, 6> H_wrench,
     gtsam::OptionalJacobian<3, 3> H_angles,
     gtsam::OptionalJacobian<3, 3> H_torques) {
-  Matrix J;
-  poe(angles, {}, J);
-  if (H_wrench) {
-    // derivative of difference with respect to wrench
-    *H_wrench = J.transpose();
-  }
-  if (H_angles) {
-    // derivative of difference with respect to angles
-
-    // The manipulator Jacobian is built such that in every step of chain
-    // composition we multiply the existing screw axes with the adjoint map of
-    // the inverse pose of the new chain, and then stack the screw axes of the
-    // new chain horizontally in the axes matrix.
-    // This means that the first angle actually doesn't get into the matrix at
-    // all. The last column of the jacobian actually doesn't depend on the
-    // angles at all, the second column depends only on the third angle, and the
-    // first column depends on the second and third angles.
-    // This means that the 3*3 jacobian has an upper triangular structure.
-    Matrix A = gtsam::Z_3x3;
-
-    // Calculate the Adjoint and take its derivative in relation to angles
-    auto ad_J_angles1 = AdjointMapJacobianQ(angles(1), Pose3(), axes_.col(1));
-    auto ad_J_angles2 = AdjointMapJacobianQ(angles(2), Pose3(), axes_.col(2));
-
-    // Calculate the invers adjoint maps of the Poses, as we do in * operator
-    Pose3 p1_inv = Pose3::Expmap(-axes_.col(1) * angles(1));
-    Pose3 p2_inv = Pose3::Expmap(-axes_.col(2) * angles(2));
-    auto ad_inv_p1 = p1_inv.AdjointMap();
-    auto ad_inv_p2 = p2_inv.AdjointMap();
-
-    // calculate the non-zero terms
-    A(1, 2) = (ad_J_angles2 * axes_.col(1)).transpose() * wrench;
-    A(0, 2) = (ad_J_angles2 * ad_inv_p1 * axes_.col(0)).transpose() * wrench;
-    A(0, 1) = (ad_inv_p2 * ad_J_angles1 * axes_.col(0)).transpose() * wrench;
-
-    *H_angles = A;
-  }
-  if (H_torques) {
-    // derivative of difference with respect to torques
-    *H_torques = -gtsam::I_3x3;
-  }
-
-  return (J.transpose() * wrench - torques);
+  return FixedChain<3>(*this).dynamicalEquality(wrench, angles, torques,
+                                                H_wrench, H_angles, H_torques);
 }
 
 gtsam::Vector3_ Chain::ChainConstraint3(
     const std::vector<JointSharedPtr> &joints, const gtsam::Key wrench_key,
     size_t k) {
-  // Get Expression for wrench
-  gtsam::Vector6_ wrench(wrench_key);
-
-  // Get expression for joint angles as a column vector of size 3.
-  gtsam::Double_ angle0(JointAngleKey(joints[0]->id(), k)),
-      angle1(JointAngleKey(joints[1]->id(), k)),
-      angle2(JointAngleKey(joints[2]->id(), k));
-  gtsam::Vector3_ angles(MakeVector3, angle0, angle1, angle2);
-
-  // Get expression for joint torques as a column vector of size 3.
-  gtsam::Double_ torque0(TorqueKey(joints[0]->id(), k)),
-      torque1(TorqueKey(joints[1]->id(), k)),
-      torque2(TorqueKey(joints[2]->id(), k));
-  gtsam::Vector3_ torques(MakeVector3, torque0, torque1, torque2);
-
-  // Get expression of the dynamical equality
-  gtsam::Vector3_ torque_diff(
-      std::bind(&Chain::DynamicalEquality3, this, std::placeholders::_1,
-                std::placeholders::_2, std::placeholders::_3,
-                std::placeholders::_4, std::placeholders::_5,
-                std::placeholders::_6),
-      wrench, angles, torques);
-
-  return torque_diff;
+  return FixedChain<3>(*this).chainConstraint(
+      {joints.begin(), joints.begin() + 3}, wrench_key, k);
 }
 
 }  // namespace gtdynamics
@@ -12,6 +12,7 @@
  */
 
 #include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/dynamics/RecursiveDynamics.h>
 #include <gtdynamics/factors/ContactDynamicsFrictionConeFactor.h>
 #include <gtdynamics/factors/ContactDynamicsMomentFactor.h>
 #include <gtdynamics/factors/ContactHeightFactor.h>
@@ -19,6 +20,7 @@
 #include <gtdynamics/factors/ContactKinematicsTwistFactor.h>
 #include <gtdynamics/universal_robot/Joint.h>
 #include <gtdynamics/utils/JsonSaver.h>
+#include <gtdynamics/utils/Parallel.h>
 #include <gtdynamics/utils/utils.h>
 #include <gtdynamics/utils/values.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
@@ -76,17 +78,12 @@ GaussianFactorGraph DynamicsGraph::linearDynamicsGraph(
           rhs[i] += gravitational_force[i - 3];
         }
       }
-      auto accel_key = TwistAccelKey(i, t);
-      if (connected_joints.size() == 0) {
-        graph.add(accel_key, G_i, rhs, all_constrained);
-      } else if (connected_joints.size() == 1) {
-        graph.add(accel_key, G_i, WrenchKey(i, connected_joints[0]->id(), t),
-                  -I_6x6, rhs, all_constrained);
-      } else if (connected_joints.size() == 2) {
-        graph.add(accel_key, G_i, WrenchKey(i, connected_joints[0]->id(), t),
-                  -I_6x6, WrenchKey(i, connected_joints[1]->id(), t), -I_6x6,
-                  rhs, all_constrained);
+      std::vector<std::pair<Key, gtsam::Matrix>> terms;
+      terms.emplace_back(TwistAccelKey(i, t), G_i);
+      for (auto &&joint : connected_joints) {
+        terms.emplace_back(WrenchKey(i, joint->id(), t), -I_6x6);
       }
+      graph.add(terms, rhs, all_constrained);
     }
   }
 
@@ -157,6 +154,15 @@ Values DynamicsGraph::linearSolveFD(const Robot &robot, const int t,
 
 Values DynamicsGraph::linearSolveID(const Robot &robot, const int t,
                                     const gtsam::Values &known_values) {
+  // Tree-structured robots are solved in O(n) with Newton-Euler recursion,
+  // which has no planar constraints.
+  if (!planar_axis_) {
+    if (auto values =
+            RecursiveDynamics(gravity_).trySolveID(robot, t, known_values)) {
+      return *values;
+    }
+  }
+
   // construct and solve linear graph
   GaussianFactorGraph graph = linearDynamicsGraph(robot, t, known_values);
   GaussianFactorGraph priors = linearIDPriors(robot, t, known_values);
@@ -360,13 +366,19 @@ gtsam::NonlinearFactorGraph DynamicsGraph::trajectoryFG(
     const Robot &robot, const int num_steps, const double dt,
     const CollocationScheme collocation,
     const std::optional<PointOnLinks> &contact_points,
-    const std::optional<double> &mu) const {
-  NonlinearFactorGraph graph;
-  for (int t = 0; t < num_steps + 1; t++) {
-    graph.add(dynamicsFactorGraph(robot, t, contact_points, mu));
-    if (t < num_steps) {
-      graph.add(collocationFactors(robot, t, dt, collocation));
+    const std::optional<double> &mu, size_t num_threads) const {
+  // Build the time slices independently, then merge them in order.
+  std::vector<NonlinearFactorGraph> slices(num_steps + 1);
+  ParallelFor(slices.size(), num_threads, [&](size_t t) {
+    slices[t] = dynamicsFactorGraph(robot, t, contact_points, mu);
+    if (static_cast<int>(t) < num_steps) {
+      slices[t].add(collocationFactors(robot, t, dt, collocation));
     }
+  });
+
+  NonlinearFactorGraph graph;
+  for (auto &&slice : slices) {
+    graph.add(slice);
   }
   return graph;
 }
@@ -376,8 +388,7 @@ gtsam::NonlinearFactorGraph DynamicsGraph::multiPhaseTrajectoryFG(
     const std::vector<gtsam::NonlinearFactorGraph> &transition_graphs,
     const CollocationScheme collocation,
     const std::optional<std::vector<PointOnLinks>> &phase_contact_points,
-    const std::optional<double> &mu) const {
-  NonlinearFactorGraph graph;
+    const std::optional<double> &mu, size_t num_threads) const {
   int num_phases = phase_steps.size();
 
   // Return either PointOnLinks or None if none specified for phase p
@@ -387,32 +398,38 @@ gtsam::NonlinearFactorGraph DynamicsGraph::multiPhaseTrajectoryFG(
     return {};
   };
 
-  // First slice, k==0
-  graph.add(dynamicsFactorGraph(robot, 0, contact_points(0), mu));
-
-  int k = 0;
+  // Phase of every time step, and whether it is a transition between phases.
+  std::vector<int> phase_of_step, phase_of_slice{0};
+  std::vector<bool> is_transition{false};
   for (int p = 0; p < num_phases; p++) {
-    // in-phase
-    // add dynamics for each step
-    for (int step = 0; step < phase_steps[p] - 1; step++) {
-      graph.add(dynamicsFactorGraph(robot, ++k, contact_points(p), mu));
-    }
-    if (p == num_phases - 1) {
-      // Last slice, k==K-1
-      graph.add(dynamicsFactorGraph(robot, ++k, contact_points(p), mu));
-    } else {
-      // transition
-      graph.add(transition_graphs[p]);
-      k++;
+    for (int step = 0; step < phase_steps[p]; step++) {
+      phase_of_step.push_back(p);
+      phase_of_slice.push_back(p);
+      is_transition.push_back(step == phase_steps[p] - 1 &&
+                              p != num_phases - 1);
     }
   }
 
-  // add collocation factors
-  k = 0;
-  for (int p = 0; p < num_phases; p++) {
-    for (int step = 0; step < phase_steps[p]; step++) {
-      graph.add(multiPhaseCollocationFactors(robot, k++, p, collocation));
+  // Build dynamics slices and collocation factors independently.
+  const size_t num_slices = phase_of_slice.size();
+  std::vector<NonlinearFactorGraph> slices(num_slices + phase_of_step.size());
+  ParallelFor(slices.size(), num_threads, [&](size_t i) {
+    if (i < num_slices) {
+      const int p = phase_of_slice[i];
+      slices[i] = is_transition[i]
+                      ? transition_graphs[p]
+                      : dynamicsFactorGraph(robot, i, contact_points(p), mu);
+    } else {
+      const size_t k = i - num_slices;
+      slices[i] = multiPhaseCollocationFactors(robot, k, phase_of_step[k],
+                                               collocation);
     }
+  });
+
+  // Merge in the order of the time steps, collocation factors last.
+  NonlinearFactorGraph graph;
+  for (auto &&slice : slices) {
+    graph.add(slice);
   }
   return graph;
 }
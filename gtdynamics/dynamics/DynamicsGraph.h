@@ -99,6 +99,9 @@ class DynamicsGraph {
 
   /**
    * Solve inverse kinodynamics using linear factor graph, Values version.
+   * Robots without kinematic loops are solved with the recursive Newton-Euler
+   * algorithm instead, see RecursiveDynamics::solveID, unless a planar axis
+   * is set.
    * @param  robot        the robot
    * @param  t            time step
    * @param known_values  Values with kinematics + joint accelerations
@@ -176,12 +179,16 @@ class DynamicsGraph {
    * @param num_steps   total time steps
    * @param dt          duration of each time step
    * @param collocation the collocation scheme
+   * @param contact_points optional contact points
+   * @param mu          optional coefficient of static friction
+   * @param num_threads number of threads used to build the time steps, 0 for
+   * all hardware threads; the factor order does not depend on it
    */
   gtsam::NonlinearFactorGraph trajectoryFG(
       const Robot &robot, const int num_steps, const double dt,
       const CollocationScheme collocation = Trapezoidal,
       const std::optional<PointOnLinks> &contact_points = {},
-      const std::optional<double> &mu = {}) const;
+      const std::optional<double> &mu = {}, size_t num_threads = 1) const;
 
   /**
    * Return nonlinear factor graph of the entire trajectory for multi-phase
@@ -191,13 +198,15 @@ class DynamicsGraph {
    * @param collocation          the collocation scheme
    * @param phase_contact_points contact points at each phase
    * @param mu                   optional coefficient of static friction
+   * @param num_threads          number of threads used to build the time
+   * steps, 0 for all hardware threads; the factor order does not depend on it
    */
   gtsam::NonlinearFactorGraph multiPhaseTrajectoryFG(
       const Robot &robot, const std::vector<int> &phase_steps,
       const std::vector<gtsam::NonlinearFactorGraph> &transition_graphs,
       const CollocationScheme collocation = Trapezoidal,
       const std::optional<std::vector<PointOnLinks>> &phase_contact_points = {},
-      const std::optional<double> &mu = {}) const;
+      const std::optional<double> &mu = {}, size_t num_threads = 1) const;
 
   /** Add collocation factor for doubles. */
   static void addCollocationFactorDouble(
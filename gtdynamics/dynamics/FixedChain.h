@@ -0,0 +1,252 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FixedChain.h
+ * @brief Serial kinematic chain with the number of joints fixed at compile
+ * time.
+ */
+
+#pragma once
+
+#include <gtdynamics/dynamics/Chain.h>
+#include <gtdynamics/universal_robot/Joint.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/OptionalJacobian.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/expressions.h>
+#include <gtsam/slam/expressions.h>
+
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace gtdynamics {
+
+/**
+ * FixedChain is a serial kinematic chain of N joints, like Chain, but with
+ * fixed-size Eigen storage. Forward kinematics, the manipulator Jacobian and
+ * the chain constraints then compile to allocation-free code, which is what
+ * the lean dynamics graph of legged robots needs in its inner loop.
+ *
+ * Screw axes are expressed in the body frame, as in Chain, and composition
+ * follows the same monoid operation (see chain.md).
+ */
+template <int N>
+class FixedChain {
+ public:
+  using Axes = Eigen::Matrix<double, 6, N>;
+  using VectorN = Eigen::Matrix<double, N, 1>;
+  using VectorN_ = gtsam::Expression<VectorN>;
+
+ private:
+  gtsam::Pose3 sMb_;  // rest pose of "body" with respect to "spatial" frame.
+  Axes axes_;         // screw axes of all joints, expressed in body frame.
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /// Number of joints in the chain.
+  static constexpr int kLength = N;
+
+  /// Default Constructor
+  FixedChain() : axes_(Axes::Zero()) {}
+
+  /// Constructor
+  FixedChain(const gtsam::Pose3 &sMb, const Axes &axes)
+      : sMb_(sMb), axes_(axes) {}
+
+  /// Construct from a dynamic Chain with N joints.
+  explicit FixedChain(const Chain &chain) : sMb_(chain.sMb()) {
+    if (chain.length() != N) {
+      throw std::invalid_argument(
+          "FixedChain: chain length differs from template length");
+    }
+    axes_ = chain.axes();
+  }
+
+  /**
+   * Create the chain of N joints, from the first joint's parent to the last
+   * joint's child link CoM, at rest.
+   * @param joints ........... Joints in the chain, from body to end-effector.
+   */
+  static FixedChain FromJoints(const std::vector<JointSharedPtr> &joints) {
+    if (joints.size() != N) {
+      throw std::invalid_argument(
+          "FixedChain: number of joints differs from template length");
+    }
+    FixedChain chain;
+    for (int i = 0; i < N; ++i) {
+      const gtsam::Pose3 pMc = joints[i]->pMc();
+      chain.axes_.leftCols(i) =
+          pMc.inverse().AdjointMap() * chain.axes_.leftCols(i);
+      chain.axes_.col(i) = joints[i]->cScrewAxis();
+      chain.sMb_ = chain.sMb_ * pMc;
+    }
+    return chain;
+  }
+
+  // Return sMb.
+  const gtsam::Pose3 &sMb() const { return sMb_; }
+
+  // Return screw axes.
+  const Axes &axes() const { return axes_; }
+
+  /**
+   * Compose two chains using the monoid operation on pose + jacobian pairs.
+   * @param other ............. chain to compose with, at the end of this one
+   * @return ....................... Composed chain
+   */
+  template <int M>
+  FixedChain<N + M> operator*(const FixedChain<M> &other) const {
+    typename FixedChain<N + M>::Axes axes;
+    axes.template leftCols<N>() =
+        other.sMb().inverse().AdjointMap() * axes_;
+    axes.template rightCols<M>() = other.axes();
+    return FixedChain<N + M>(sMb_ * other.sMb(), axes);
+  }
+
+  /**
+   * Perform forward kinematics given q, return Pose of end-effector and
+   * optionally the Jacobian.
+   * @param q ........... Input angles for all joints
+   * @param fTe ......... The end-effector pose with respect to final link
+   * (Optional)
+   * @param(out) J....... Manipulator Jacobian in the end-effector frame
+   * (Optional)
+   * @return ............ Pose of the end-effector calculated using Product of
+   * Exponentials
+   */
+  gtsam::Pose3 poe(const VectorN &q,
+                   const std::optional<gtsam::Pose3> &fTe = {},
+                   gtsam::OptionalJacobian<6, N> J = {}) const {
+    gtsam::Pose3 sTe = sMb_;
+    Axes axes;
+    for (int i = 0; i < N; ++i) {
+      const gtsam::Pose3 exp = gtsam::Pose3::Expmap(axes_.col(i) * q(i));
+      if (J) {
+        axes.leftCols(i) = exp.inverse().AdjointMap() * axes.leftCols(i);
+        axes.col(i) = axes_.col(i);
+      }
+      sTe = sTe * exp;
+    }
+    if (fTe) {
+      sTe = sTe * (*fTe);
+      if (J) axes = fTe->inverse().AdjointMap() * axes;
+    }
+    if (J) *J = axes;
+    return sTe;
+  }
+
+  /**
+   * The dynamic dependency between the joint torques and the wrench applied
+   * on the body, tau = J^T F, for massless links (see chain.md).
+   *
+   * The derivative of column i of the Jacobian with respect to angle k > i is
+   * -ad(J_k) J_i, and zero otherwise, so all derivatives follow from the
+   * Jacobian itself.
+   *
+   * @param wrench .................. Wrench applied on the body by the joint
+   * closest to it in the chain.
+   * @param angles .................. Angles of the joints in the chain.
+   * @param torques ................. Torques applied by the joints.
+   * @return ........................ Vector of difference.
+   */
+  VectorN dynamicalEquality(
+      const gtsam::Vector6 &wrench, const VectorN &angles,
+      const VectorN &torques, gtsam::OptionalJacobian<N, 6> H_wrench = {},
+      gtsam::OptionalJacobian<N, N> H_angles = {},
+      gtsam::OptionalJacobian<N, N> H_torques = {}) const {
+    Axes J;
+    poe(angles, {}, J);
+    if (H_wrench) *H_wrench = J.transpose();
+    if (H_angles) {
+      H_angles->setZero();
+      for (int k = 1; k < N; ++k) {
+        const gtsam::Vector6 adT_wrench =
+            -gtsam::Pose3::adjointMap(J.col(k)).transpose() * wrench;
+        for (int i = 0; i < k; ++i) {
+          (*H_angles)(i, k) = J.col(i).dot(adT_wrench);
+        }
+      }
+    }
+    if (H_torques) *H_torques = -Eigen::Matrix<double, N, N>::Identity();
+    return J.transpose() * wrench - torques;
+  }
+
+  /**
+   * Expression of the end-effector pose sTe for the angles of the joints in
+   * the chain at time k.
+   *
+   * @param joints ............... Joints in the chain, in the order of the
+   * screw axes.
+   * @param k .................... Time slice.
+   * @return ..................... GTSAM expression of the end-effector pose.
+   */
+  gtsam::Pose3_ forwardKinematics(const std::vector<JointSharedPtr> &joints,
+                                  size_t k) const {
+    // The expression keeps its own copy of the chain.
+    const FixedChain chain = *this;
+    auto fk = [chain](const VectorN &angles, gtsam::OptionalJacobian<6, N> H) {
+      return chain.poe(angles, {}, H);
+    };
+    return gtsam::Pose3_(fk, Stack(joints, k, JointAngleKey));
+  }
+
+  /**
+   * Expression of the chain constraint, tau = J^T F, for the joints in the
+   * chain at time k.
+   *
+   * @param joints ............... Joints in the chain, in the order of the
+   * screw axes.
+   * @param wrench_key ........... Key of the wrench applied on the body by the
+   * joint closest to the body.
+   * @param k .................... Time slice.
+   * @return ..................... GTSAM expression of the chain constraint.
+   */
+  VectorN_ chainConstraint(const std::vector<JointSharedPtr> &joints,
+                           gtsam::Key wrench_key, size_t k) const {
+    const FixedChain chain = *this;
+    auto equality = [chain](const gtsam::Vector6 &wrench,
+                            const VectorN &angles, const VectorN &torques,
+                            gtsam::OptionalJacobian<N, 6> H_wrench,
+                            gtsam::OptionalJacobian<N, N> H_angles,
+                            gtsam::OptionalJacobian<N, N> H_torques) {
+      return chain.dynamicalEquality(wrench, angles, torques, H_wrench,
+                                     H_angles, H_torques);
+    };
+    return VectorN_(equality, gtsam::Vector6_(wrench_key),
+                    Stack(joints, k, JointAngleKey),
+                    Stack(joints, k, TorqueKey));
+  }
+
+ private:
+  /// Expression of the joint variables with keys key(j, k), as a vector.
+  template <typename KEY>
+  static VectorN_ Stack(const std::vector<JointSharedPtr> &joints, size_t k,
+                        KEY &&key) {
+    if (joints.size() != N) {
+      throw std::invalid_argument(
+          "FixedChain: number of joints differs from template length");
+    }
+    const VectorN zero = VectorN::Zero();
+    VectorN_ stacked(zero);
+    for (int i = 0; i < N; ++i) {
+      auto unit = [i](double x, gtsam::OptionalJacobian<N, 1> H) {
+        VectorN v = VectorN::Zero();
+        v(i) = x;
+        if (H) *H = VectorN::Unit(i);
+        return v;
+      };
+      stacked = stacked +
+                VectorN_(unit, gtsam::Double_(key(joints[i]->id(), k)));
+    }
+    return stacked;
+  }
+};
+
+}  // namespace gtdynamics
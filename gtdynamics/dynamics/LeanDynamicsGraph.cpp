@@ -0,0 +1,175 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file LeanDynamicsGraph.cpp
+ * @brief Dynamics graph of a legged robot with massless legs.
+ */
+
+#include <gtdynamics/dynamics/LeanDynamicsGraph.h>
+#include <gtdynamics/factors/ContactDynamicsMomentFactor.h>
+#include <gtdynamics/factors/WrenchFactor.h>
+#include <gtdynamics/utils/Parallel.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using gtsam::NonlinearFactorGraph;
+using gtsam::OptionalJacobian;
+using gtsam::Pose3;
+using gtsam::Vector6;
+
+namespace gtdynamics {
+
+namespace {
+/**
+ * Chain from the foot CoM to the body CoM, for joints ordered from the foot to
+ * the body. Traversing a joint from child to parent, the rest pose is cMp and
+ * the screw axis is the one expressed in the parent frame.
+ */
+LeanDynamicsGraph::LegChain ReversedChain(
+    const std::vector<JointSharedPtr> &joints) {
+  LeanDynamicsGraph::LegChain::Axes axes;
+  Pose3 sMb;
+  for (int i = 0; i < LeanDynamicsGraph::kLegJoints; ++i) {
+    const Pose3 cMp = joints[i]->pMc().inverse();
+    axes.leftCols(i) = cMp.inverse().AdjointMap() * axes.leftCols(i);
+    axes.col(i) = joints[i]->pScrewAxis();
+    sMb = sMb * cMp;
+  }
+  return LeanDynamicsGraph::LegChain(sMb, axes);
+}
+}  // namespace
+
+LeanDynamicsGraph::LeanDynamicsGraph(const Robot &robot,
+                                     const std::string &body_name,
+                                     const gtsam::Vector3 &gravity,
+                                     const OptimizerSetting &opt)
+    : body_(robot.link(body_name)), gravity_(gravity), opt_(opt) {
+  for (auto &&hip : body_->joints()) {
+    if (hip->parent() != body_) continue;
+
+    // Follow the leg down to the foot.
+    Leg leg;
+    JointSharedPtr joint = hip;
+    while (joint) {
+      leg.joints.push_back(joint);
+      const LinkSharedPtr link = joint->child();
+      joint = nullptr;
+      for (auto &&next : link->joints()) {
+        if (next->parent() != link) continue;
+        if (joint) {
+          throw std::invalid_argument("LeanDynamicsGraph: leg of joint " +
+                                      hip->name() + " is not a serial chain");
+        }
+        joint = next;
+      }
+      leg.foot = link;
+    }
+    if (leg.joints.size() != static_cast<size_t>(kLegJoints)) {
+      throw std::invalid_argument("LeanDynamicsGraph: leg of joint " +
+                                  hip->name() + " does not have " +
+                                  std::to_string(kLegJoints) + " joints");
+    }
+    std::reverse(leg.joints.begin(), leg.joints.end());
+    leg.chain = ReversedChain(leg.joints);
+    legs_.push_back(leg);
+  }
+
+  // One torque cost model per joint of the leg.
+  auto torque_model = std::dynamic_pointer_cast<gtsam::noiseModel::Gaussian>(
+      opt_.t_cost_model);
+  if (!torque_model) {
+    throw std::invalid_argument(
+        "LeanDynamicsGraph: torque cost model should be Gaussian");
+  }
+  chain_cost_model_ = gtsam::noiseModel::Isotropic::Sigma(
+      kLegJoints, torque_model->sigmas()(0));
+}
+
+NonlinearFactorGraph LeanDynamicsGraph::dynamicsFactors(
+    const int k, const std::optional<PointOnLinks> &contact_points) const {
+  NonlinearFactorGraph graph;
+  const int i = body_->id();
+
+  std::vector<gtsam::Key> wrench_keys;
+  for (auto &&leg : legs_) {
+    const gtsam::Key wrench_key = WrenchKey(i, leg.joints.back()->id(), k);
+    wrench_keys.push_back(wrench_key);
+
+    // Torques needed to apply the leg wrench on the body.
+    graph.add(gtsam::ExpressionFactor<gtsam::Vector3>(
+        chain_cost_model_, gtsam::Vector3::Zero(),
+        leg.chain.chainConstraint(leg.joints, wrench_key, k)));
+
+    std::optional<gtsam::Point3> contact_point;
+    if (contact_points) {
+      for (auto &&cp : *contact_points) {
+        if (cp.link->id() == leg.foot->id()) contact_point = cp.point;
+      }
+    }
+    if (!contact_point) {
+      // A swing leg applies no wrench on the body.
+      graph.emplace_shared<gtsam::PriorFactor<Vector6>>(
+          wrench_key, gtsam::Z_6x1, opt_.f_cost_model);
+      continue;
+    }
+
+    // The contact wrench on the foot, in the foot CoM frame, is transmitted
+    // to the body: F_body = Ad(fTb)^T F_foot.
+    const gtsam::Key contact_key = ContactWrenchKey(leg.foot->id(), 0, k);
+    auto transmit = [](const Pose3 &fTb, const Vector6 &wrench,
+                       OptionalJacobian<6, 6> H_pose,
+                       OptionalJacobian<6, 6> H_wrench) {
+      return fTb.AdjointTranspose(wrench, H_pose, H_wrench);
+    };
+    gtsam::Vector6_ body_wrench(transmit,
+                                leg.chain.forwardKinematics(leg.joints, k),
+                                gtsam::Vector6_(contact_key));
+    graph.add(gtsam::ExpressionFactor<Vector6>(
+        opt_.f_cost_model, gtsam::Z_6x1,
+        body_wrench - gtsam::Vector6_(wrench_key)));
+
+    graph.emplace_shared<ContactDynamicsMomentFactor>(
+        contact_key, opt_.cm_cost_model,
+        Pose3(gtsam::Rot3(), -(*contact_point)));
+  }
+
+  graph.add(WrenchFactor(opt_.fa_cost_model, body_, wrench_keys, k, gravity_));
+  return graph;
+}
+
+NonlinearFactorGraph LeanDynamicsGraph::trajectoryFG(
+    const int num_steps, const double dt, const CollocationScheme collocation,
+    const std::optional<PointOnLinks> &contact_points,
+    size_t num_threads) const {
+  const DynamicsGraph graph_builder(opt_, gravity_);
+
+  // Build the time slices independently, then merge them in order.
+  std::vector<NonlinearFactorGraph> slices(num_steps + 1);
+  ParallelFor(slices.size(), num_threads, [&](size_t t) {
+    slices[t] = dynamicsFactors(t, contact_points);
+    if (static_cast<int>(t) >= num_steps) return;
+    for (auto &&leg : legs_) {
+      for (auto &&joint : leg.joints) {
+        slices[t].add(graph_builder.jointCollocationFactors(joint->id(), t, dt,
+                                                            collocation));
+      }
+    }
+  });
+
+  NonlinearFactorGraph graph;
+  for (auto &&slice : slices) {
+    graph.add(slice);
+  }
+  return graph;
+}
+
+}  // namespace gtdynamics
@@ -0,0 +1,115 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file LeanDynamicsGraph.h
+ * @brief Dynamics graph of a legged robot with massless legs, each leg
+ * collapsed into a kinematic chain.
+ */
+
+#pragma once
+
+#include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/dynamics/FixedChain.h>
+#include <gtdynamics/dynamics/OptimizerSetting.h>
+#include <gtdynamics/universal_robot/Robot.h>
+#include <gtdynamics/utils/PointOnLink.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gtdynamics {
+
+/**
+ * LeanDynamicsGraph builds the dynamics graph of a legged robot in which every
+ * leg is a massless serial chain between the body and a foot (see chain.md).
+ *
+ * Instead of the poses, twists, accelerations and wrenches of every leg link,
+ * the graph has variables for
+ *  - the body: pose, twist, twist acceleration, and the wrench each leg
+ *    applies on it, WrenchKey(body, hip, k),
+ *  - the joints: angles, velocities, accelerations and torques,
+ *  - the feet in contact: the contact wrench, ContactWrenchKey(foot, 0, k).
+ *
+ * Per time step, there is one wrench balance factor on the body, and per leg
+ * a chain constraint tau = J^T F between the leg wrench on the body and the
+ * joint torques. The wrench of a foot in contact is transmitted to the body
+ * through the chain, and a swing leg applies no wrench.
+ *
+ * Friction cones are not added, as the foot poses are not variables.
+ */
+class LeanDynamicsGraph {
+ public:
+  /// Number of joints in every leg.
+  static constexpr int kLegJoints = 3;
+
+  using LegChain = FixedChain<kLegJoints>;
+
+  /// A leg, as a chain from the foot CoM to the body CoM.
+  struct Leg {
+    std::vector<JointSharedPtr> joints;  ///< from the foot to the body.
+    LinkSharedPtr foot;
+    LegChain chain;  ///< pose of the body in the foot frame, at rest.
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+ private:
+  LinkSharedPtr body_;
+  std::vector<Leg> legs_;
+  gtsam::Vector3 gravity_;
+  OptimizerSetting opt_;
+  gtsam::SharedNoiseModel chain_cost_model_;
+
+ public:
+  /**
+   * Constructor. Every joint of the body starts a leg, which has to be a
+   * serial chain of kLegJoints joints.
+   * @param robot     the robot
+   * @param body_name name of the body link
+   * @param gravity   gravity in world frame
+   * @param opt       settings for the cost models
+   */
+  LeanDynamicsGraph(const Robot &robot, const std::string &body_name,
+                    const gtsam::Vector3 &gravity = gtsam::Vector3(0, 0, -9.8),
+                    const OptimizerSetting &opt = OptimizerSetting());
+
+  /// Return the body link.
+  const LinkSharedPtr &body() const { return body_; }
+
+  /// Return the legs.
+  const std::vector<Leg> &legs() const { return legs_; }
+
+  /**
+   * Return the dynamics factors at time step k.
+   * @param k              time step
+   * @param contact_points feet in contact, all legs swing if not given
+   */
+  gtsam::NonlinearFactorGraph dynamicsFactors(
+      const int k,
+      const std::optional<PointOnLinks> &contact_points = {}) const;
+
+  /**
+   * Return nonlinear factor graph of the entire trajectory. As in
+   * DynamicsGraph::trajectoryFG, the joint states are collocated.
+   * @param num_steps      total time steps
+   * @param dt             duration of each time step
+   * @param collocation    the collocation scheme
+   * @param contact_points feet in contact
+   * @param num_threads    number of threads used to build the time steps, 0
+   * for all hardware threads; the factor order does not depend on it
+   */
+  gtsam::NonlinearFactorGraph trajectoryFG(
+      const int num_steps, const double dt,
+      const CollocationScheme collocation = Trapezoidal,
+      const std::optional<PointOnLinks> &contact_points = {},
+      size_t num_threads = 1) const;
+};
+
+}  // namespace gtdynamics
@@ -0,0 +1,317 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  RecursiveDynamics.cpp
+ * @brief Recursive O(n) dynamics algorithms for tree-structured robots.
+ */
+
+#include <gtdynamics/dynamics/Dynamics.h>
+#include <gtdynamics/dynamics/RecursiveDynamics.h>
+#include <gtdynamics/statics/Statics.h>
+#include <gtdynamics/universal_robot/Joint.h>
+#include <gtdynamics/universal_robot/Link.h>
+#include <gtdynamics/utils/values.h>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using gtsam::Matrix6;
+using gtsam::Pose3;
+using gtsam::Values;
+using gtsam::Vector6;
+
+namespace gtdynamics {
+
+namespace {
+
+/// A link in traversal order, with the joint connecting it to its parent.
+struct TreeNode {
+  LinkSharedPtr link;
+  JointSharedPtr joint;  // nullptr for root links
+  int parent;            // index of the parent in the traversal, -1 for roots
+};
+
+/**
+ * Order the links of a robot breadth-first, so that every link comes after
+ * its parent. Fixed links are used as roots first, and the remaining
+ * connected components are rooted at an arbitrary link (floating base).
+ * Returns false if a loop is detected.
+ */
+bool TraversalOrder(const Robot &robot, std::vector<TreeNode> *order) {
+  constexpr size_t kMaxIds = std::numeric_limits<uint8_t>::max() + 1;
+  std::vector<bool> link_visited(kMaxIds, false), joint_visited(kMaxIds, false);
+
+  auto links = robot.links();
+  std::stable_partition(
+      links.begin(), links.end(),
+      [](const LinkSharedPtr &link) { return link->isFixed(); });
+
+  order->clear();
+  order->reserve(links.size());
+  for (auto &&root : links) {
+    if (link_visited[root->id()]) continue;
+    link_visited[root->id()] = true;
+    size_t head = order->size();
+    order->push_back({root, nullptr, -1});
+    while (head < order->size()) {
+      const LinkSharedPtr link = (*order)[head].link;
+      for (auto &&joint : link->joints()) {
+        if (joint_visited[joint->id()]) continue;
+        joint_visited[joint->id()] = true;
+        const auto other = joint->otherLink(link);
+        // Reaching a link twice, or a second fixed link, closes a loop.
+        if (link_visited[other->id()] || other->isFixed()) return false;
+        link_visited[other->id()] = true;
+        order->push_back({other, joint, static_cast<int>(head)});
+      }
+      ++head;
+    }
+  }
+  return true;
+}
+
+/// Terms of the Newton-Euler equations that only depend on the kinematics,
+/// indexed by position in the traversal order.
+struct NewtonEulerTerms {
+  std::vector<gtsam::Matrix6> G;   // link inertia matrices
+  std::vector<gtsam::Matrix6> Ad;  // adjoint map of T_kp, parent to link k
+  std::vector<gtsam::Vector6> S;   // screw axis of the joint to the parent
+  std::vector<gtsam::Vector6> c;   // velocity-product acceleration
+  std::vector<gtsam::Vector6> p;   // bias wrench
+};
+
+/**
+ * Evaluate the kinematic terms from the link poses and twists and the joint
+ * velocities in known_values. The bias wrench is -(ad(V)^T * G * V + gravity
+ * wrench), such that the wrench on a link by its parent joint is
+ * F = G * A + p - (wrenches by its child joints).
+ */
+NewtonEulerTerms ComputeTerms(const std::vector<TreeNode> &order,
+                              const gtsam::Values &known_values, int t,
+                              const std::optional<gtsam::Vector3> &gravity) {
+  const size_t n = order.size();
+  NewtonEulerTerms terms;
+  terms.G.resize(n);
+  terms.Ad.resize(n);
+  terms.S.resize(n);
+  terms.c.resize(n);
+  terms.p.resize(n);
+
+  std::vector<Pose3> T_w(n);
+  for (size_t k = 0; k < n; ++k) {
+    const auto &node = order[k];
+    const auto &link = node.link;
+    T_w[k] = Pose(known_values, link->id(), t);
+    const Vector6 V = Twist(known_values, link->id(), t);
+
+    terms.G[k] = link->inertiaMatrix();
+    terms.p[k] = -Coriolis(terms.G[k], V);
+    if (gravity) {
+      terms.p[k] -= GravityWrench(*gravity, link->mass(), T_w[k]);
+    }
+
+    if (node.joint) {
+      terms.Ad[k] = T_w[k].between(T_w[node.parent]).AdjointMap();
+      terms.S[k] = node.joint->screwAxis(link);
+      const double q_dot = JointVel(known_values, node.joint->id(), t);
+      terms.c[k] = Pose3::adjointMap(V) * terms.S[k] * q_dot;
+    } else {
+      terms.Ad[k].setIdentity();
+      terms.S[k].setZero();
+      terms.c[k].setZero();
+    }
+  }
+  return terms;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+bool RecursiveDynamics::IsTree(const Robot &robot) {
+  std::vector<TreeNode> order;
+  return TraversalOrder(robot, &order);
+}
+
+/* ************************************************************************* */
+Values RecursiveDynamics::solveFD(const Robot &robot, const int t,
+                                  const Values &known_values) const {
+  std::vector<TreeNode> order;
+  if (!TraversalOrder(robot, &order)) {
+    throw std::invalid_argument(
+        "RecursiveDynamics::solveFD: robot contains kinematic loops, use "
+        "DynamicsGraph::linearSolveFD instead.");
+  }
+  const size_t n = order.size();
+  const auto terms = ComputeTerms(order, known_values, t, gravity_);
+  const auto &Ad = terms.Ad, &S = terms.S, &c = terms.c;
+
+  // Articulated-body inertias and bias wrenches start as those of the links.
+  std::vector<Matrix6> IA = terms.G;
+  std::vector<Vector6> pA = terms.p, U(n), A(n), F(n);
+  std::vector<double> D(n), u(n), qddot(n, 0.0);
+
+  // Inward pass: accumulate articulated-body inertias and bias wrenches.
+  for (size_t k = n; k-- > 0;) {
+    const auto &node = order[k];
+    if (!node.joint) continue;
+
+    Matrix6 Ia = IA[k];
+    Vector6 pa = pA[k];
+    if (node.joint->type() != Joint::Type::Fixed) {
+      U[k] = IA[k] * S[k];
+      D[k] = S[k].dot(U[k]);
+      u[k] = Torque(known_values, node.joint->id(), t) - S[k].dot(pA[k]);
+      Ia -= U[k] * U[k].transpose() / D[k];
+      pa += U[k] * u[k] / D[k];
+    }
+    pa += Ia * c[k];
+
+    const int p = node.parent;
+    IA[p] += Ad[k].transpose() * Ia * Ad[k];
+    pA[p] += Ad[k].transpose() * pa;
+  }
+
+  // Outward pass: joint and twist accelerations, and wrenches.
+  for (size_t k = 0; k < n; ++k) {
+    const auto &node = order[k];
+    if (!node.joint) {
+      // Fixed roots do not move, floating roots have no wrench acting on them.
+      if (node.link->isFixed()) {
+        A[k].setZero();
+      } else {
+        A[k] = -IA[k].ldlt().solve(pA[k]);
+      }
+      continue;
+    }
+    const Vector6 A_hat = Ad[k] * A[node.parent] + c[k];
+    if (node.joint->type() != Joint::Type::Fixed) {
+      qddot[k] = (u[k] - U[k].dot(A_hat)) / D[k];
+    }
+    A[k] = A_hat + S[k] * qddot[k];
+    F[k] = IA[k] * A[k] + pA[k];
+  }
+
+  // arrange values
+  Values values = known_values;
+  try {
+    for (size_t k = 0; k < n; ++k) {
+      const auto &node = order[k];
+      const int i = node.link->id();
+      if (node.joint) {
+        const int j = node.joint->id();
+        const int p = order[node.parent].link->id();
+        InsertJointAccel(&values, j, t, qddot[k]);
+        InsertWrench(&values, i, j, t, F[k]);
+        InsertWrench(&values, p, j, t, -Ad[k].transpose() * F[k]);
+      }
+      InsertTwistAccel(&values, i, t, A[k]);
+    }
+  } catch (const gtsam::ValuesKeyAlreadyExists &e) {
+    std::cerr << "key already exists:" << _GTDKeyFormatter(e.key()) << '\n';
+    throw std::invalid_argument(
+        "RecursiveDynamics::solveFD: known_values should contain no "
+        "accelerations or wrenches");
+  }
+  return values;
+}
+
+/* ************************************************************************* */
+Values RecursiveDynamics::solveID(const Robot &robot, const int t,
+                                  const Values &known_values) const {
+  std::optional<Values> values = trySolveID(robot, t, known_values);
+  if (!values) {
+    throw std::invalid_argument(
+        "RecursiveDynamics::solveID: robot contains kinematic loops, use "
+        "DynamicsGraph::linearSolveID instead.");
+  }
+  return std::move(*values);
+}
+
+/* ************************************************************************* */
+std::optional<Values> RecursiveDynamics::trySolveID(
+    const Robot &robot, const int t, const Values &known_values) const {
+  std::vector<TreeNode> order;
+  if (!TraversalOrder(robot, &order)) return std::nullopt;
+  const size_t n = order.size();
+  const auto terms = ComputeTerms(order, known_values, t, gravity_);
+  const auto &G = terms.G, &Ad = terms.Ad, &S = terms.S, &c = terms.c;
+
+  std::vector<double> qddot(n, 0.0);
+  for (size_t k = 0; k < n; ++k) {
+    const auto &joint = order[k].joint;
+    if (joint && joint->type() != Joint::Type::Fixed) {
+      qddot[k] = JointAccel(known_values, joint->id(), t);
+    }
+  }
+
+  // Twist accelerations of the roots, zero for fixed links.
+  std::vector<Vector6> A(n), F(n), A_root(n, Vector6::Zero());
+
+  // Two-pass recursive Newton-Euler for given root accelerations. After the
+  // inward pass, F of a root is the wrench needed to realize its acceleration.
+  auto newtonEuler = [&]() {
+    for (size_t k = 0; k < n; ++k) {
+      const auto &node = order[k];
+      A[k] = node.joint ? Vector6(Ad[k] * A[node.parent] + c[k] +
+                                  S[k] * qddot[k])
+                        : A_root[k];
+      F[k] = G[k] * A[k] + terms.p[k];
+    }
+    for (size_t k = n; k-- > 0;) {
+      const auto &node = order[k];
+      if (node.joint) F[node.parent] += Ad[k].transpose() * F[k];
+    }
+  };
+  newtonEuler();
+
+  // Floating roots have no wrench acting on them. Since the residual wrench
+  // is affine in the root acceleration, with the composite rigid-body inertia
+  // as its slope, solve for the acceleration and repeat the recursion.
+  bool has_floating_root = false;
+  std::vector<Matrix6> Ic = G;
+  for (size_t k = n; k-- > 0;) {
+    const auto &node = order[k];
+    if (node.joint) {
+      Ic[node.parent] += Ad[k].transpose() * Ic[k] * Ad[k];
+    } else if (!node.link->isFixed()) {
+      A_root[k] = -Ic[k].ldlt().solve(F[k]);
+      has_floating_root = true;
+    }
+  }
+  if (has_floating_root) newtonEuler();
+
+  // arrange values
+  Values values = known_values;
+  try {
+    for (size_t k = 0; k < n; ++k) {
+      const auto &node = order[k];
+      const int i = node.link->id();
+      if (node.joint) {
+        const int j = node.joint->id();
+        const int p = order[node.parent].link->id();
+        InsertTorque(&values, j, t,
+                     node.joint->transformWrenchToTorque(node.link, F[k]));
+        InsertWrench(&values, i, j, t, F[k]);
+        InsertWrench(&values, p, j, t, -Ad[k].transpose() * F[k]);
+      }
+      InsertTwistAccel(&values, i, t, A[k]);
+    }
+  } catch (const gtsam::ValuesKeyAlreadyExists &e) {
+    std::cerr << "key already exists:" << _GTDKeyFormatter(e.key()) << '\n';
+    throw std::invalid_argument(
+        "RecursiveDynamics::solveID: known_values should contain no torques, "
+        "wrenches, or twist accelerations.");
+  }
+  return values;
+}
+
+}  // namespace gtdynamics
@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  RecursiveDynamics.h
+ * @brief Recursive O(n) dynamics algorithms for tree-structured robots.
+ */
+
+#pragma once
+
+#include <gtdynamics/universal_robot/Robot.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <optional>
+
+namespace gtdynamics {
+
+/**
+ * RecursiveDynamics solves the dynamics of a single time step by recursing
+ * over the link-joint tree of a robot (Featherstone, Rigid Body Dynamics
+ * Algorithms, 2008), instead of building and eliminating the linear factor
+ * graph used by DynamicsGraph. The conventions (CoM frames, wrenches applied
+ * on each link by each joint) and the returned Values layout are identical to
+ * DynamicsGraph::linearSolveFD and DynamicsGraph::linearSolveID.
+ *
+ * Fixed links are roots with zero twist acceleration; every connected
+ * component without a fixed link is treated as a floating base. Robots with
+ * kinematic loops are not supported, see IsTree.
+ */
+class RecursiveDynamics {
+ private:
+  std::optional<gtsam::Vector3> gravity_;
+
+ public:
+  /**
+   * Constructor
+   * @param  gravity      gravity in world frame
+   */
+  explicit RecursiveDynamics(const std::optional<gtsam::Vector3> &gravity = {})
+      : gravity_(gravity) {}
+
+  /**
+   * Solve forward dynamics with the Articulated-Body Algorithm.
+   *
+   * @param robot        the robot, must not contain loops
+   * @param t            time step
+   * @param known_values Values with link poses and twists, joint angles,
+   * joint velocities and torques
+   * @return known_values with joint accelerations, wrenches, and link twist
+   * accelerations added
+   */
+  gtsam::Values solveFD(const Robot &robot, const int t,
+                        const gtsam::Values &known_values) const;
+
+  /**
+   * Solve inverse dynamics with the Recursive Newton-Euler Algorithm. For
+   * floating bases, the base acceleration is solved from the composite
+   * rigid-body inertia such that no wrench acts on the base.
+   *
+   * @param robot        the robot, must not contain loops
+   * @param t            time step
+   * @param known_values Values with link poses and twists, joint angles,
+   * joint velocities and joint accelerations
+   * @return known_values with torques, wrenches, and link twist accelerations
+   * added
+   */
+  gtsam::Values solveID(const Robot &robot, const int t,
+                        const gtsam::Values &known_values) const;
+
+  /**
+   * Solve inverse dynamics as solveID, but return std::nullopt instead of
+   * throwing if the robot contains kinematic loops. Unlike IsTree followed by
+   * solveID, this traverses the robot only once.
+   */
+  std::optional<gtsam::Values> trySolveID(
+      const Robot &robot, const int t,
+      const gtsam::Values &known_values) const;
+
+  /// Return true if the link-joint graph of the robot contains no loops.
+  static bool IsTree(const Robot &robot);
+};
+
+}  // namespace gtdynamics
@@ -14,15 +14,27 @@
 #pragma once
 
 #include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/dynamics/RecursiveDynamics.h>
 #include <gtdynamics/universal_robot/Robot.h>
 #include <gtdynamics/utils/values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace gtdynamics {
+
+/**
+ * Forward dynamics solvers available to the Simulator.
+ *
+ * FactorGraphSolver: DynamicsGraph::linearSolveFD, works for any robot.
+ * ArticulatedBodySolver: RecursiveDynamics::solveFD, O(n) but trees only,
+ * and without planar constraints.
+ */
+enum ForwardDynamicsSolver { FactorGraphSolver, ArticulatedBodySolver };
+
 /**
  * Simulator is a class which simulate robot arm motion using forward
  * dynamics.
@@ -32,6 +44,8 @@ class Simulator {
   Robot robot_;
   int t_;
   DynamicsGraph graph_builder_;
+  RecursiveDynamics recursive_dynamics_;
+  ForwardDynamicsSolver solver_;
   gtsam::Values initial_values_;
   std::optional<gtsam::Vector3> gravity_;
   std::optional<gtsam::Vector3> planar_axis_;
@@ -47,14 +61,22 @@ class Simulator {
    * @param initial_values initial joint angles and velocities
    * @param gravity        gravity vector
    * @param planar_axis    planar axis vector
+   * @param solver         forward dynamics solver to use
    */
   Simulator(const Robot &robot, const gtsam::Values &initial_values,
             const std::optional<gtsam::Vector3> &gravity = {},
-            const std::optional<gtsam::Vector3> &planar_axis = {})
+            const std::optional<gtsam::Vector3> &planar_axis = {},
+            const ForwardDynamicsSolver solver = FactorGraphSolver)
       : robot_(robot),
         t_(0),
         graph_builder_(DynamicsGraph(gravity, planar_axis)),
+        recursive_dynamics_(gravity),
+        solver_(solver),
         initial_values_(initial_values) {
+    if (solver == ArticulatedBodySolver && planar_axis) {
+      throw std::invalid_argument(
+          "Simulator: ArticulatedBodySolver does not support a planar axis.");
+    }
     reset();
   }
   ~Simulator() {}
@@ -80,7 +102,11 @@ class Simulator {
     }
 
     // Now compute accelerations with forward dynamics
-    current_values_ = graph_builder_.linearSolveFD(robot_, 0, values);
+    if (solver_ == ArticulatedBodySolver) {
+      current_values_ = recursive_dynamics_.solveFD(robot_, 0, values);
+    } else {
+      current_values_ = graph_builder_.linearSolveFD(robot_, 0, values);
+    }
   }
 
   /**
@@ -2,6 +2,8 @@
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
 
+#include <cmath>
+
 namespace gtsam {
 
 /** A factor that adds a constant bias term to the original factor.
@@ -56,6 +58,20 @@ class BiasedFactor : public NoiseModelFactor {
     return base_factor_->unwhitenedError(x, H) + bias_;
   }
 
+  /// Return the bias term.
+  const Vector &bias() const { return bias_; }
+
+  /// Replace the bias term, e.g., with updated Lagrange multipliers.
+  void setBias(const Vector &bias) { bias_ = bias; }
+
+  /** Weigh the squared error by the penalty parameter mu, relative to the
+   * noise model of the base factor, i.e., the noise model becomes the one of
+   * the base factor with sigmas divided by sqrt(mu). */
+  void setPenalty(double mu) {
+    noiseModel_ = noiseModel::Diagonal::Sigmas(
+        base_factor_->noiseModel()->sigmas() / std::sqrt(mu));
+  }
+
   /** Return a deep copy of this factor. */
   gtsam::NonlinearFactor::shared_ptr clone() const override {
     return std::static_pointer_cast<gtsam::NonlinearFactor>(
@@ -0,0 +1,526 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  JointTypedFactors.h
+ * @brief Joint factors specialized on the joint type, with closed-form
+ * fixed-size Jacobians.
+ */
+
+#pragma once
+
+#include <gtdynamics/universal_robot/HelicalJoint.h>
+#include <gtdynamics/universal_robot/Joint.h>
+#include <gtdynamics/universal_robot/Link.h>
+#include <gtdynamics/universal_robot/PrismaticJoint.h>
+#include <gtdynamics/universal_robot/RevoluteJoint.h>
+#include <gtdynamics/utils/DynamicsSymbol.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/Vector.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace gtdynamics {
+
+/**
+ * Joint geometry needed by the joint factors: the rest pose pMc of the child
+ * CoM in the parent CoM frame, and the screw axis S in the child CoM frame,
+ * such that pTc(q) = pMc * exp(S * q).
+ *
+ * The exponential map is specialized on the joint type: revolute joints are a
+ * pure rotation about an axis, prismatic joints a pure translation, and
+ * helical (and fixed) joints use the general SE(3) exponential map.
+ *
+ * Since exp(S * (q + d)) = exp(S * q) * exp(S * d), the derivative of pTc(q)
+ * in the tangent space of pTc is S itself, which the factors below use
+ * instead of the Jacobian of the exponential map.
+ */
+template <class JOINT>
+class JointKernel {
+  gtsam::Pose3 pMc_;
+  gtsam::Vector6 S_;
+
+ public:
+  JointKernel() {}
+
+  /// Copy the geometry of the given joint.
+  explicit JointKernel(const Joint &joint)
+      : pMc_(joint.pMc()), S_(joint.cScrewAxis()) {}
+
+  /// Screw axis in the child CoM frame.
+  const gtsam::Vector6 &screwAxis() const { return S_; }
+
+  /// Exponential map of the joint motion S * q.
+  static gtsam::Pose3 Expmap(const gtsam::Vector6 &S, double q) {
+    return gtsam::Pose3::Expmap(S * q);
+  }
+
+  /// Pose of the child CoM in the parent CoM frame.
+  gtsam::Pose3 parentTchild(double q) const { return pMc_ * Expmap(S_, q); }
+
+  /// Pose of the parent CoM in the child CoM frame.
+  gtsam::Pose3 childTparent(double q) const {
+    return parentTchild(q).inverse();
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int /*version*/) {
+    ar &BOOST_SERIALIZATION_NVP(pMc_);
+    ar &BOOST_SERIALIZATION_NVP(S_);
+  }
+#endif
+};
+
+/// Rotation about the axis (w, v): R = exp(w q), t = (I - R) (w x v) / |w|^2.
+template <>
+inline gtsam::Pose3 JointKernel<RevoluteJoint>::Expmap(const gtsam::Vector6 &S,
+                                                       double q) {
+  const gtsam::Vector3 w = S.head<3>(), v = S.tail<3>();
+  const gtsam::Rot3 R = gtsam::Rot3::Expmap(w * q);
+  const gtsam::Vector3 t =
+      (gtsam::I_3x3 - R.matrix()) * w.cross(v) / w.squaredNorm();
+  return gtsam::Pose3(R, t);
+}
+
+/// Translation along v.
+template <>
+inline gtsam::Pose3 JointKernel<PrismaticJoint>::Expmap(
+    const gtsam::Vector6 &S, double q) {
+  return gtsam::Pose3(gtsam::Rot3(), S.tail<3>() * q);
+}
+
+/**
+ * TypedPoseFactor is a three-way nonlinear factor between a joint's parent
+ * link pose, child link pose, and the joint angle relating the two poses, with
+ * the same error as Joint::poseConstraint:
+ *
+ *   error = log(wTc^{-1} * wTp * pTc(q)).
+ */
+template <class JOINT>
+class TypedPoseFactor
+    : public gtsam::NoiseModelFactorN<gtsam::Pose3, gtsam::Pose3, double> {
+ private:
+  using This = TypedPoseFactor<JOINT>;
+  using Base = gtsam::NoiseModelFactorN<gtsam::Pose3, gtsam::Pose3, double>;
+
+  JointKernel<JOINT> kernel_;
+
+ public:
+  TypedPoseFactor() {}
+
+  /**
+   * Constructor with custom keys.
+   * @param wTp_key Key for parent link's CoM pose in world frame.
+   * @param wTc_key Key for child link's CoM pose in world frame.
+   * @param q_key Key for the joint angle.
+   * @param cost_model The noise model for this factor.
+   * @param joint The joint connecting the two poses.
+   */
+  TypedPoseFactor(gtsam::Key wTp_key, gtsam::Key wTc_key, gtsam::Key q_key,
+                  const gtsam::SharedNoiseModel &cost_model,
+                  const JointConstSharedPtr &joint)
+      : Base(cost_model, wTp_key, wTc_key, q_key), kernel_(*joint) {}
+
+  /**
+   * Constructor.
+   * @param cost_model The noise model for this factor.
+   * @param joint The joint connecting the two poses.
+   * @param t The timestep at which this factor is defined.
+   */
+  TypedPoseFactor(const gtsam::SharedNoiseModel &cost_model,
+                  const JointConstSharedPtr &joint, size_t t)
+      : TypedPoseFactor(PoseKey(joint->parent()->id(), t),
+                        PoseKey(joint->child()->id(), t),
+                        JointAngleKey(joint->id(), t), cost_model, joint) {}
+
+  gtsam::Vector evaluateError(
+      const gtsam::Pose3 &wTp, const gtsam::Pose3 &wTc, const double &q,
+      gtsam::OptionalMatrixType H_wTp = nullptr,
+      gtsam::OptionalMatrixType H_wTc = nullptr,
+      gtsam::OptionalMatrixType H_q = nullptr) const override {
+    const gtsam::Pose3 pTc = kernel_.parentTchild(q);
+    if (!H_wTp && !H_wTc && !H_q) {
+      return gtsam::Pose3::Logmap(wTc.between(wTp * pTc));
+    }
+
+    gtsam::Matrix6 H_hat_wTp, H_between_wTc, H_log;
+    const gtsam::Pose3 wTc_hat = wTp.compose(pTc, H_hat_wTp);
+    const gtsam::Pose3 cTc_hat = wTc.between(wTc_hat, H_between_wTc);
+    const gtsam::Vector6 error = gtsam::Pose3::Logmap(cTc_hat, H_log);
+
+    // The derivatives of between and compose w.r.t. wTc_hat and pTc are
+    // identity.
+    if (H_wTp) *H_wTp = H_log * H_hat_wTp;
+    if (H_wTc) *H_wTc = H_log * H_between_wTc;
+    if (H_q) *H_q = H_log * kernel_.screwAxis();
+    return error;
+  }
+
+  /// @return a deep copy of this factor
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return std::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print contents
+  void print(const std::string &s = "",
+             const gtsam::KeyFormatter &keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override {
+    std::cout << s << "joint pose factor" << std::endl;
+    Base::print("", keyFormatter);
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int version) {  // NOLINT
+    ar &boost::serialization::make_nvp(
+        "NoiseModelFactorN", boost::serialization::base_object<Base>(*this));
+    ar &BOOST_SERIALIZATION_NVP(kernel_);
+  }
+#endif
+};
+
+/**
+ * TypedTwistFactor is a four-way nonlinear factor which enforces the relation
+ * between the twists of the parent and child link, with the same error as
+ * Joint::twistConstraint:
+ *
+ *   error = Ad(cTp(q)) * V_p + S * q_dot - V_c.
+ */
+template <class JOINT>
+class TypedTwistFactor
+    : public gtsam::NoiseModelFactorN<gtsam::Vector6, gtsam::Vector6, double,
+                                      double> {
+ private:
+  using This = TypedTwistFactor<JOINT>;
+  using Base = gtsam::NoiseModelFactorN<gtsam::Vector6, gtsam::Vector6,
+                                        double, double>;
+
+  JointKernel<JOINT> kernel_;
+
+ public:
+  TypedTwistFactor() {}
+
+  /**
+   * Constructor.
+   * @param cost_model The noise model for this factor.
+   * @param joint The joint connecting the two links.
+   * @param t The timestep at which this factor is defined.
+   */
+  TypedTwistFactor(const gtsam::SharedNoiseModel &cost_model,
+                   const JointConstSharedPtr &joint, size_t t)
+      : Base(cost_model, TwistKey(joint->parent()->id(), t),
+             TwistKey(joint->child()->id(), t), JointAngleKey(joint->id(), t),
+             JointVelKey(joint->id(), t)),
+        kernel_(*joint) {}
+
+  gtsam::Vector evaluateError(
+      const gtsam::Vector6 &twist_p, const gtsam::Vector6 &twist_c,
+      const double &q, const double &q_dot,
+      gtsam::OptionalMatrixType H_twist_p = nullptr,
+      gtsam::OptionalMatrixType H_twist_c = nullptr,
+      gtsam::OptionalMatrixType H_q = nullptr,
+      gtsam::OptionalMatrixType H_q_dot = nullptr) const override {
+    const gtsam::Vector6 &S = kernel_.screwAxis();
+    const gtsam::Matrix6 Ad = kernel_.childTparent(q).AdjointMap();
+    const gtsam::Vector6 twist_from_p = Ad * twist_p;
+
+    if (H_twist_p) *H_twist_p = Ad;
+    if (H_twist_c) *H_twist_c = -gtsam::I_6x6;
+    // d/dq Ad(exp(-S q) cMp) V_p = -ad(S) Ad V_p = ad(Ad V_p) S.
+    if (H_q) *H_q = gtsam::Pose3::adjointMap(twist_from_p) * S;
+    if (H_q_dot) *H_q_dot = S;
+    return twist_from_p + S * q_dot - twist_c;
+  }
+
+  /// @return a deep copy of this factor
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return std::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print contents
+  void print(const std::string &s = "",
+             const gtsam::KeyFormatter &keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override {
+    std::cout << s << "joint twist factor" << std::endl;
+    Base::print("", keyFormatter);
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int version) {  // NOLINT
+    ar &boost::serialization::make_nvp(
+        "NoiseModelFactorN", boost::serialization::base_object<Base>(*this));
+    ar &BOOST_SERIALIZATION_NVP(kernel_);
+  }
+#endif
+};
+
+/**
+ * TypedTwistAccelFactor is a six-way nonlinear factor which enforces the
+ * relation between the twist accelerations of the parent and child link, with
+ * the same error as Joint::twistAccelConstraint:
+ *
+ *   error = Ad(cTp(q)) * A_p + ad(V_c) * S * q_dot + S * q_ddot - A_c.
+ */
+template <class JOINT>
+class TypedTwistAccelFactor
+    : public gtsam::NoiseModelFactorN<gtsam::Vector6, gtsam::Vector6,
+                                      gtsam::Vector6, double, double, double> {
+ private:
+  using This = TypedTwistAccelFactor<JOINT>;
+  using Base = gtsam::NoiseModelFactorN<gtsam::Vector6, gtsam::Vector6,
+                                        gtsam::Vector6, double, double, double>;
+
+  JointKernel<JOINT> kernel_;
+
+ public:
+  TypedTwistAccelFactor() {}
+
+  /**
+   * Constructor.
+   * @param cost_model The noise model for this factor.
+   * @param joint The joint connecting the two links.
+   * @param t The timestep at which this factor is defined.
+   */
+  TypedTwistAccelFactor(const gtsam::SharedNoiseModel &cost_model,
+                        const JointConstSharedPtr &joint, size_t t)
+      : Base(cost_model, TwistKey(joint->child()->id(), t),
+             TwistAccelKey(joint->parent()->id(), t),
+             TwistAccelKey(joint->child()->id(), t),
+             JointAngleKey(joint->id(), t), JointVelKey(joint->id(), t),
+             JointAccelKey(joint->id(), t)),
+        kernel_(*joint) {}
+
+  gtsam::Vector evaluateError(
+      const gtsam::Vector6 &twist_c, const gtsam::Vector6 &twist_accel_p,
+      const gtsam::Vector6 &twist_accel_c, const double &q,
+      const double &q_dot, const double &q_ddot,
+      gtsam::OptionalMatrixType H_twist_c = nullptr,
+      gtsam::OptionalMatrixType H_twist_accel_p = nullptr,
+      gtsam::OptionalMatrixType H_twist_accel_c = nullptr,
+      gtsam::OptionalMatrixType H_q = nullptr,
+      gtsam::OptionalMatrixType H_q_dot = nullptr,
+      gtsam::OptionalMatrixType H_q_ddot = nullptr) const override {
+    const gtsam::Vector6 &S = kernel_.screwAxis();
+    const gtsam::Matrix6 Ad = kernel_.childTparent(q).AdjointMap();
+    const gtsam::Vector6 accel_from_p = Ad * twist_accel_p;
+    const gtsam::Matrix6 ad_twist_c = gtsam::Pose3::adjointMap(twist_c);
+
+    if (H_twist_c) *H_twist_c = -gtsam::Pose3::adjointMap(S * q_dot);
+    if (H_twist_accel_p) *H_twist_accel_p = Ad;
+    if (H_twist_accel_c) *H_twist_accel_c = -gtsam::I_6x6;
+    if (H_q) *H_q = gtsam::Pose3::adjointMap(accel_from_p) * S;
+    if (H_q_dot) *H_q_dot = ad_twist_c * S;
+    if (H_q_ddot) *H_q_ddot = S;
+    return accel_from_p + ad_twist_c * S * q_dot + S * q_ddot - twist_accel_c;
+  }
+
+  /// @return a deep copy of this factor
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return std::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print contents
+  void print(const std::string &s = "",
+             const gtsam::KeyFormatter &keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override {
+    std::cout << s << "joint twist acceleration factor" << std::endl;
+    Base::print("", keyFormatter);
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int version) {  // NOLINT
+    ar &boost::serialization::make_nvp(
+        "NoiseModelFactorN", boost::serialization::base_object<Base>(*this));
+    ar &BOOST_SERIALIZATION_NVP(kernel_);
+  }
+#endif
+};
+
+/**
+ * TypedWrenchEquivalenceFactor is a three-way nonlinear factor which enforces
+ * that the joint wrenches on the parent and child link are equal and
+ * opposite, with the same error as Joint::wrenchEquivalenceConstraint:
+ *
+ *   error = F_p + Ad(cTp(q))^T * F_c.
+ */
+template <class JOINT>
+class TypedWrenchEquivalenceFactor
+    : public gtsam::NoiseModelFactorN<gtsam::Vector6, gtsam::Vector6, double> {
+ private:
+  using This = TypedWrenchEquivalenceFactor<JOINT>;
+  using Base =
+      gtsam::NoiseModelFactorN<gtsam::Vector6, gtsam::Vector6, double>;
+
+  JointKernel<JOINT> kernel_;
+
+ public:
+  TypedWrenchEquivalenceFactor() {}
+
+  /**
+   * Constructor.
+   * @param cost_model The noise model for this factor.
+   * @param joint The joint connecting the two links.
+   * @param t The timestep at which this factor is defined.
+   */
+  TypedWrenchEquivalenceFactor(const gtsam::SharedNoiseModel &cost_model,
+                               const JointConstSharedPtr &joint, size_t t)
+      : Base(cost_model, WrenchKey(joint->parent()->id(), joint->id(), t),
+             WrenchKey(joint->child()->id(), joint->id(), t),
+             JointAngleKey(joint->id(), t)),
+        kernel_(*joint) {}
+
+  gtsam::Vector evaluateError(
+      const gtsam::Vector6 &wrench_p, const gtsam::Vector6 &wrench_c,
+      const double &q, gtsam::OptionalMatrixType H_wrench_p = nullptr,
+      gtsam::OptionalMatrixType H_wrench_c = nullptr,
+      gtsam::OptionalMatrixType H_q = nullptr) const override {
+    const gtsam::Matrix6 AdT =
+        kernel_.childTparent(q).AdjointMap().transpose();
+
+    if (H_wrench_p) *H_wrench_p = gtsam::I_6x6;
+    if (H_wrench_c) *H_wrench_c = AdT;
+    // d/dq Ad(exp(-S q) cMp)^T F_c = -Ad^T ad(S)^T F_c.
+    if (H_q) {
+      *H_q = -AdT * (gtsam::Pose3::adjointMap(kernel_.screwAxis()).transpose() *
+                     wrench_c);
+    }
+    return wrench_p + AdT * wrench_c;
+  }
+
+  /// @return a deep copy of this factor
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return std::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print contents
+  void print(const std::string &s = "",
+             const gtsam::KeyFormatter &keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override {
+    std::cout << s << "joint wrench equivalence factor" << std::endl;
+    Base::print("", keyFormatter);
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int version) {  // NOLINT
+    ar &boost::serialization::make_nvp(
+        "NoiseModelFactorN", boost::serialization::base_object<Base>(*this));
+    ar &BOOST_SERIALIZATION_NVP(kernel_);
+  }
+#endif
+};
+
+/**
+ * TypedTorqueFactor is a two-way nonlinear factor which enforces that the
+ * torque is the child-side joint wrench projected on the screw axis, with the
+ * same error as Joint::torqueConstraint:
+ *
+ *   error = S^T * F_c - torque.
+ */
+template <class JOINT>
+class TypedTorqueFactor
+    : public gtsam::NoiseModelFactorN<gtsam::Vector6, double> {
+ private:
+  using This = TypedTorqueFactor<JOINT>;
+  using Base = gtsam::NoiseModelFactorN<gtsam::Vector6, double>;
+
+  JointKernel<JOINT> kernel_;
+
+ public:
+  TypedTorqueFactor() {}
+
+  /**
+   * Constructor.
+   * @param cost_model The noise model for this factor.
+   * @param joint The joint connecting the two links.
+   * @param t The timestep at which this factor is defined.
+   */
+  TypedTorqueFactor(const gtsam::SharedNoiseModel &cost_model,
+                     const JointConstSharedPtr &joint, size_t t)
+      : Base(cost_model, WrenchKey(joint->child()->id(), joint->id(), t),
+             TorqueKey(joint->id(), t)),
+        kernel_(*joint) {}
+
+  gtsam::Vector evaluateError(
+      const gtsam::Vector6 &wrench_c, const double &torque,
+      gtsam::OptionalMatrixType H_wrench_c = nullptr,
+      gtsam::OptionalMatrixType H_torque = nullptr) const override {
+    const gtsam::Vector6 &S = kernel_.screwAxis();
+    if (H_wrench_c) *H_wrench_c = S.transpose();
+    if (H_torque) *H_torque = -gtsam::I_1x1;
+    return gtsam::Vector1(S.dot(wrench_c) - torque);
+  }
+
+  /// @return a deep copy of this factor
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return std::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print contents
+  void print(const std::string &s = "",
+             const gtsam::KeyFormatter &keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override {
+    std::cout << s << "joint torque factor" << std::endl;
+    Base::print("", keyFormatter);
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int version) {  // NOLINT
+    ar &boost::serialization::make_nvp(
+        "NoiseModelFactorN", boost::serialization::base_object<Base>(*this));
+    ar &BOOST_SERIALIZATION_NVP(kernel_);
+  }
+#endif
+};
+
+/**
+ * Create the joint factor FACTOR specialized on the type of the given joint.
+ * Fixed joints use the general (helical) kernel.
+ * @param joint The joint, which is passed to the factor constructor as well.
+ * @param args Constructor arguments, including the joint.
+ */
+template <template <class> class FACTOR, class... ARGS>
+gtsam::NoiseModelFactor::shared_ptr MakeTypedJointFactor(
+    const JointConstSharedPtr &joint, const ARGS &...args) {
+  switch (joint->type()) {
+    case Joint::Type::Revolute:
+      return std::make_shared<FACTOR<RevoluteJoint>>(args...);
+    case Joint::Type::Prismatic:
+      return std::make_shared<FACTOR<PrismaticJoint>>(args...);
+    default:
+      return std::make_shared<FACTOR<HelicalJoint>>(args...);
+  }
+}
+
+}  // namespace gtdynamics
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <gtdynamics/factors/JointTypedFactors.h>
 #include <gtdynamics/universal_robot/Joint.h>
 #include <gtdynamics/universal_robot/Link.h>
 #include <gtsam/base/Matrix.h>
@@ -45,8 +46,8 @@ namespace gtdynamics {
 inline gtsam::NoiseModelFactor::shared_ptr PoseFactor(
     const gtsam::SharedNoiseModel &cost_model, const JointConstSharedPtr &joint,
     int time) {
-  return std::make_shared<gtsam::ExpressionFactor<gtsam::Vector6>>(
-      cost_model, gtsam::Vector6::Zero(), joint->poseConstraint(time));
+  return MakeTypedJointFactor<TypedPoseFactor>(joint, cost_model, joint,
+                                               size_t(time));
 }
 
 /**
@@ -63,9 +64,9 @@ inline gtsam::NoiseModelFactor::shared_ptr PoseFactor(
     DynamicsSymbol wTp_key, DynamicsSymbol wTc_key, DynamicsSymbol q_key,
     const gtsam::noiseModel::Base::shared_ptr &cost_model,
     JointConstSharedPtr joint) {
-  return std::make_shared<gtsam::ExpressionFactor<gtsam::Vector6>>(
-      cost_model, gtsam::Vector6::Zero(),
-      joint->poseConstraint(wTp_key, wTc_key, q_key));
+  return MakeTypedJointFactor<TypedPoseFactor>(
+      joint, gtsam::Key(wTp_key), gtsam::Key(wTc_key), gtsam::Key(q_key),
+      cost_model, joint);
 }
 
 }  // namespace gtdynamics
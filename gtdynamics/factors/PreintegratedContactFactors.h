@@ -135,8 +135,8 @@ class PreintegratedPointContactFactor
       gtsam::OptionalMatrixType H_wTb_j = nullptr,
       gtsam::OptionalMatrixType H_wTc_j = nullptr) const override {
     // Compute the error.
-    gtsam::Vector3 error = wTb_i.rotation().transpose() *
-                           (wTc_j.translation() - wTc_i.translation());
+    const gtsam::Matrix3 bRw = wTb_i.rotation().transpose();
+    gtsam::Vector3 error = bRw * (wTc_j.translation() - wTc_i.translation());
 
     // Please refer to the supplementary material for the Jacobian calculations.
     // https://arxiv.org/src/1712.05873v2/anc/icra-supplementary-material.pdf
@@ -145,26 +145,20 @@ class PreintegratedPointContactFactor
       H << gtsam::SO3::Hat(error), gtsam::Z_3x3;
       *H_wTb_i = H;
     }
+    // The paper aligns the contact frame with the body frame, in which case
+    // these reduce to -I and Rci^T * Rcj. The general form below also holds
+    // for a contact frame attached to the foot.
     if (H_wTc_i) {
       gtsam::Matrix36 H;
-      H << gtsam::Z_3x3, -gtsam::I_3x3;
+      H << gtsam::Z_3x3, -bRw * wTc_i.rotation().matrix();
       *H_wTc_i = H;
     }
     if (H_wTb_j) {
       *H_wTb_j = gtsam::Matrix36::Zero();
     }
     if (H_wTc_j) {
-      // Assert the rotation of the contact frame is the same as the rotation of
-      // the body frame. This will ensure the retraction is d <- d + δR as per
-      // the paper.
-      if (!wTc_i.rotation().equals(wTb_i.rotation()) ||
-          !wTc_j.rotation().equals(wTb_j.rotation())) {
-        throw std::runtime_error(
-            "Body rotation and contact rotation are not equal.");
-      }
       gtsam::Matrix36 H;
-      H << gtsam::Z_3x3,
-          (wTc_i.rotation().inverse() * wTc_j.rotation()).matrix();
+      H << gtsam::Z_3x3, bRw * wTc_j.rotation().matrix();
       *H_wTc_j = H;
     }
     return error;
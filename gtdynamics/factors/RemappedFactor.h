@@ -0,0 +1,172 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  RemappedFactor.h
+ * @brief Evaluate a shared factor on a different set of keys.
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/Vector.h>
+#include <gtsam/linear/GaussianFactor.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+namespace gtdynamics {
+
+/**
+ * A factor that evaluates a template factor on other variables, without
+ * copying it. The i-th key of this factor takes the place of the i-th key of
+ * the template factor.
+ *
+ * This is needed for factors that capture their keys internally, e.g.,
+ * ExpressionFactor, for which NonlinearFactor::rekey would only change the
+ * key list but not the expression. The template factor, including its
+ * expression tree and noise model, is shared between all remapped copies.
+ *
+ * Evaluating the factor assigns the values of the new keys, in place, to a
+ * cached Values under the keys of the template factor. Only the first
+ * evaluation allocates. The cache is guarded by a mutex, so a factor can be
+ * evaluated from several threads.
+ */
+class RemappedFactor : public gtsam::NoiseModelFactor {
+ private:
+  using This = RemappedFactor;
+  using Base = gtsam::NoiseModelFactor;
+
+  Base::shared_ptr base_factor_;
+
+  /// Values under the keys of the template factor, reused by evaluations.
+  mutable gtsam::Values base_x_;
+  mutable std::mutex mutex_;
+
+  /**
+   * Call function on the template factor, with the values of the new keys
+   * under the keys of the template factor.
+   */
+  template <typename FUNCTION>
+  auto withBaseValues(const gtsam::Values &x, FUNCTION &&function) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const gtsam::KeyVector &base_keys = base_factor_->keys();
+    for (size_t i = 0; i < size(); i++) {
+      const gtsam::Value &value = x.at(keys()[i]);
+      if (!base_x_.exists(base_keys[i])) {
+        base_x_.insert(base_keys[i], value);
+        continue;
+      }
+      // base_x_ owns its values, so assigning through at() is safe.
+      const gtsam::Value &cached = base_x_.at(base_keys[i]);
+      if (typeid(cached) == typeid(value)) {
+        const_cast<gtsam::Value &>(cached) = value;
+      } else {
+        base_x_.update(base_keys[i], value);
+      }
+    }
+    return function(base_x_);
+  }
+
+ public:
+  /** Default constructor for I/O only */
+  RemappedFactor() {}
+
+  /**
+   * Constructor
+   * @param base_factor template factor
+   * @param keys new keys, one for each key of the template factor
+   */
+  RemappedFactor(const Base::shared_ptr &base_factor,
+                 const gtsam::KeyVector &keys)
+      : Base(base_factor->noiseModel(), keys), base_factor_(base_factor) {
+    if (keys.size() != base_factor->size()) {
+      throw std::invalid_argument(
+          "RemappedFactor: number of keys does not match the template factor.");
+    }
+  }
+
+  /// Copy constructor, which does not copy the cached values.
+  RemappedFactor(const RemappedFactor &other)
+      : Base(other), base_factor_(other.base_factor_) {}
+
+  ~RemappedFactor() override {}
+
+  /// The template factor.
+  const Base::shared_ptr &baseFactor() const { return base_factor_; }
+
+  /**
+   * Evaluate the template factor on values of the new keys.
+   * @param x values of the new keys
+   * @param H Jacobians, in the order of the keys
+   */
+  gtsam::Vector unwhitenedError(
+      const gtsam::Values &x,
+      gtsam::OptionalMatrixVecType H = nullptr) const override {
+    return withBaseValues(x, [&](const gtsam::Values &base_x) {
+      return base_factor_->unwhitenedError(base_x, H);
+    });
+  }
+
+  /// Whether the template factor is active on values of the new keys.
+  bool active(const gtsam::Values &x) const override {
+    return withBaseValues(x, [&](const gtsam::Values &base_x) {
+      return base_factor_->active(base_x);
+    });
+  }
+
+  /// Linearize the template factor, and rename its keys to the new keys.
+  std::shared_ptr<gtsam::GaussianFactor> linearize(
+      const gtsam::Values &x) const override {
+    auto linear = withBaseValues(x, [&](const gtsam::Values &base_x) {
+      return base_factor_->linearize(base_x);
+    });
+    if (!linear) return linear;
+    const gtsam::KeyVector &base_keys = base_factor_->keys();
+    for (gtsam::Key &key : linear->keys()) {
+      const auto it = std::find(base_keys.begin(), base_keys.end(), key);
+      key = keys()[it - base_keys.begin()];
+    }
+    return linear;
+  }
+
+  /** Return a deep copy of this factor. */
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return std::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print contents
+  void print(const std::string &s = "",
+             const gtsam::KeyFormatter &keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override {
+    std::cout << s << "RemappedFactor\n";
+    Base::print("", keyFormatter);
+    base_factor_->print("  template: ", keyFormatter);
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int /*version*/) {
+    ar &boost::serialization::make_nvp(
+        "NoiseModelFactor", boost::serialization::base_object<Base>(*this));
+    ar &BOOST_SERIALIZATION_NVP(base_factor_);
+  }
+#endif
+};
+
+}  // namespace gtdynamics
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <gtdynamics/factors/JointTypedFactors.h>
 #include <gtdynamics/universal_robot/Joint.h>
 #include <gtdynamics/universal_robot/Link.h>
 #include <gtdynamics/utils/values.h>
@@ -44,8 +45,7 @@ namespace gtdynamics {
 inline gtsam::NoiseModelFactor::shared_ptr TorqueFactor(
     const gtsam::noiseModel::Base::shared_ptr &cost_model,
     const JointConstSharedPtr &joint, size_t k = 0) {
-  return std::make_shared<gtsam::ExpressionFactor<double>>(
-      cost_model, 0.0, joint->torqueConstraint(k));
+  return MakeTypedJointFactor<TypedTorqueFactor>(joint, cost_model, joint, k);
 }
 
 }  // namespace gtdynamics
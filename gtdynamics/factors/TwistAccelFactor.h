@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <gtdynamics/factors/JointTypedFactors.h>
 #include <gtdynamics/universal_robot/Joint.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/Vector.h>
@@ -44,8 +45,8 @@ namespace gtdynamics {
 inline gtsam::NoiseModelFactor::shared_ptr TwistAccelFactor(
     const gtsam::noiseModel::Base::shared_ptr &cost_model,
     JointConstSharedPtr joint, int time) {
-  return std::make_shared<gtsam::ExpressionFactor<gtsam::Vector6>>(
-      cost_model, gtsam::Vector6::Zero(), joint->twistAccelConstraint(time));
+  return MakeTypedJointFactor<TypedTwistAccelFactor>(joint, cost_model, joint,
+                                                     size_t(time));
 }
 
 }  // namespace gtdynamics
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <gtdynamics/factors/JointTypedFactors.h>
 #include <gtdynamics/universal_robot/Joint.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/Vector.h>
@@ -40,8 +41,8 @@ namespace gtdynamics {
 inline gtsam::NoiseModelFactor::shared_ptr TwistFactor(
     const gtsam::noiseModel::Base::shared_ptr &cost_model,
     JointConstSharedPtr joint, int time) {
-  return std::make_shared<gtsam::ExpressionFactor<gtsam::Vector6>>(
-      cost_model, gtsam::Vector6::Zero(), joint->twistConstraint(time));
+  return MakeTypedJointFactor<TypedTwistFactor>(joint, cost_model, joint,
+                                                size_t(time));
 }
 
 }  // namespace gtdynamics
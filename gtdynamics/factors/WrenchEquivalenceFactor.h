@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <gtdynamics/factors/JointTypedFactors.h>
 #include <gtdynamics/universal_robot/Joint.h>
 #include <gtdynamics/universal_robot/Link.h>
 #include <gtdynamics/utils/values.h>
@@ -40,9 +41,8 @@ namespace gtdynamics {
 inline gtsam::NoiseModelFactor::shared_ptr WrenchEquivalenceFactor(
     const gtsam::noiseModel::Base::shared_ptr &cost_model,
     const JointConstSharedPtr &joint, size_t k = 0) {
-  return std::make_shared<gtsam::ExpressionFactor<gtsam::Vector6>>(
-      cost_model, gtsam::Vector6::Zero(),
-      joint->wrenchEquivalenceConstraint(k));
+  return MakeTypedJointFactor<TypedWrenchEquivalenceFactor>(joint, cost_model,
+                                                            joint, k);
 }
 
 }  // namespace gtdynamics
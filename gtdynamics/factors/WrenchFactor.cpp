@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  WrenchFactor.cpp
+ * @brief Wrench balance factor with closed-form Jacobians.
+ */
+
+#include <gtdynamics/dynamics/Dynamics.h>
+#include <gtdynamics/factors/WrenchFactor.h>
+#include <gtdynamics/statics/Statics.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/OptionalJacobian.h>
+#include <gtsam/base/Vector.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <optional>
+#include <vector>
+
+using gtsam::Matrix;
+using gtsam::Matrix6;
+using gtsam::Pose3;
+using gtsam::Values;
+using gtsam::Vector;
+using gtsam::Vector6;
+
+namespace gtdynamics {
+
+/* ************************************************************************* */
+WrenchBalanceFactor::WrenchBalanceFactor(
+    const gtsam::SharedNoiseModel &cost_model, const LinkConstSharedPtr &link,
+    const std::vector<gtsam::Key> &wrench_keys, int t,
+    const std::optional<gtsam::Vector3> &gravity)
+    : Base(cost_model, gtsam::KeyVector{TwistKey(link->id(), t),
+                                        TwistAccelKey(link->id(), t)}),
+      inertia_(link->inertiaMatrix()),
+      mass_(link->mass()),
+      gravity_(gravity) {
+  keys_.insert(keys_.end(), wrench_keys.begin(), wrench_keys.end());
+  if (gravity_) keys_.push_back(PoseKey(link->id(), t));
+}
+
+/* ************************************************************************* */
+Vector WrenchBalanceFactor::unwhitenedError(
+    const Values &x, gtsam::OptionalMatrixVecType H) const {
+  if (!this->active(x)) {
+    return Vector::Zero(this->dim());
+  }
+
+  const Vector6 &twist = x.at<Vector6>(keys_[0]);
+  const Vector6 &twist_accel = x.at<Vector6>(keys_[1]);
+
+  // Coriolis and momentum terms, both linear or quadratic in the twist.
+  Matrix6 H_twist;
+  Vector6 error = Coriolis(inertia_, twist, H ? &H_twist : nullptr) -
+                  inertia_ * twist_accel;
+
+  // External wrenches enter with identity Jacobians.
+  const size_t num_wrenches = numWrenches();
+  for (size_t i = 0; i < num_wrenches; ++i) {
+    error += x.at<Vector6>(keys_[2 + i]);
+  }
+
+  Matrix6 H_pose;
+  if (gravity_) {
+    error += GravityWrench(*gravity_, mass_, x.at<Pose3>(keys_.back()),
+                           H ? &H_pose : nullptr);
+  }
+
+  if (H) {
+    (*H)[0] = H_twist;
+    (*H)[1] = -inertia_;
+    for (size_t i = 0; i < num_wrenches; ++i) {
+      (*H)[2 + i] = gtsam::I_6x6;
+    }
+    if (gravity_) (*H)[2 + num_wrenches] = H_pose;
+  }
+  return error;
+}
+
+}  // namespace gtdynamics
@@ -19,10 +19,11 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/linear/NoiseModel.h>
-#include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/nonlinear/Values.h>
 
+#include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -30,9 +31,83 @@
 namespace gtdynamics {
 
 /**
- * WrenchFactor is an n-way nonlinear factor which enforces relation
- * between wrenches on this link
+ * WrenchBalanceFactor is an n-way nonlinear factor which enforces relation
+ * between wrenches on this link, i.e., Lynch & Park Equation 8.48:
+ *
+ *   error = ad(V)^T G V - G A + sum_i F_i + F_gravity(wTcom),
+ *
+ * which has the same definition as Link::wrenchConstraint, but is evaluated
+ * directly with closed-form Jacobians instead of through an expression tree.
+ * The keys are ordered as: twist, twist acceleration, *wrenches, and the link
+ * pose if gravity is given.
  */
+class WrenchBalanceFactor : public gtsam::NoiseModelFactor {
+  using This = WrenchBalanceFactor;
+  using Base = gtsam::NoiseModelFactor;
+
+  gtsam::Matrix6 inertia_;
+  double mass_;
+  std::optional<gtsam::Vector3> gravity_;
+
+ public:
+  /** Default constructor for I/O only */
+  WrenchBalanceFactor() {}
+
+  /**
+   * Wrench balance factor.
+   * @param cost_model Cost model to regulate constraint.
+   * @param link Link on which the wrenches act.
+   * @param wrench_keys Keys for the wrenches acting on the link.
+   * @param t Integer time index.
+   * @param gravity (optional) Gravity vector in world frame.
+   */
+  WrenchBalanceFactor(const gtsam::SharedNoiseModel &cost_model,
+                      const LinkConstSharedPtr &link,
+                      const std::vector<gtsam::Key> &wrench_keys, int t,
+                      const std::optional<gtsam::Vector3> &gravity = {});
+
+  ~WrenchBalanceFactor() override {}
+
+  /// Number of external wrenches.
+  size_t numWrenches() const { return size() - (gravity_ ? 3 : 2); }
+
+  /**
+   * Evaluate the resultant wrench, which should be zero and is factor error.
+   * @param x contains the twist, twist acceleration, wrenches and pose.
+   * @param H Jacobians, in the order of the keys.
+   */
+  gtsam::Vector unwhitenedError(
+      const gtsam::Values &x,
+      gtsam::OptionalMatrixVecType H = nullptr) const override;
+
+  /// @return a deep copy of this factor
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return std::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print contents
+  void print(const std::string &s = "",
+             const gtsam::KeyFormatter &keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override {
+    std::cout << s << "wrench balance factor" << std::endl;
+    Base::print("", keyFormatter);
+  }
+
+ private:
+#ifdef GTDYNAMICS_ENABLE_BOOST_SERIALIZATION
+  /// Serialization function
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE &ar, const unsigned int version) {  // NOLINT
+    ar &boost::serialization::make_nvp(
+        "NoiseModelFactor", boost::serialization::base_object<Base>(*this));
+    ar &BOOST_SERIALIZATION_NVP(inertia_);
+    ar &BOOST_SERIALIZATION_NVP(mass_);
+    ar &BOOST_SERIALIZATION_NVP(gravity_);
+  }
+#endif
+};
 
 /**
  * Wrench balance factor, common between forward and inverse dynamics.
@@ -44,9 +119,8 @@ inline gtsam::NoiseModelFactor::shared_ptr WrenchFactor(
     const gtsam::SharedNoiseModel &cost_model, const LinkConstSharedPtr &link,
     const std::vector<gtsam::Key> &wrench_keys, int time,
     const std::optional<gtsam::Vector3> &gravity = {}) {
-  return std::make_shared<gtsam::ExpressionFactor<gtsam::Vector6>>(
-      cost_model, gtsam::Vector6::Zero(),
-      link->wrenchConstraint(wrench_keys, time, gravity));
+  return std::make_shared<WrenchBalanceFactor>(cost_model, link, wrench_keys,
+                                               time, gravity);
 }
 
 }  // namespace gtdynamics
@@ -0,0 +1,215 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  AnalyticIK.cpp
+ * @brief Closed-form inverse kinematics for kinematic sub-chains of a robot.
+ */
+
+#include <gtdynamics/kinematics/AnalyticIK.h>
+#include <gtsam/geometry/Rot3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gtdynamics {
+
+using gtsam::Point3;
+using gtsam::Pose3;
+using gtsam::Vector;
+using gtsam::Vector3;
+
+/* ************************************************************************* */
+std::vector<JointSharedPtr> KinematicChain(const Robot &robot,
+                                           const std::string &base_link,
+                                           const std::string &tip_link) {
+  std::vector<JointSharedPtr> chain;
+  LinkSharedPtr link = robot.link(tip_link);
+  while (link->name() != base_link) {
+    JointSharedPtr parent_joint;
+    for (auto &&joint : link->joints()) {
+      if (joint->child() == link) parent_joint = joint;
+    }
+    if (!parent_joint) {
+      throw std::invalid_argument("KinematicChain: " + tip_link +
+                                  " is not a descendant of " + base_link);
+    }
+    chain.push_back(parent_joint);
+    link = parent_joint->parent();
+  }
+  std::reverse(chain.begin(), chain.end());
+  return chain;
+}
+
+/* ************************************************************************* */
+AnalyticIK::AnalyticIK(const Robot &robot, const std::string &base_link,
+                       const std::string &tip_link)
+    : base_link_(base_link), tip_link_(tip_link) {
+  for (auto &&joint : KinematicChain(robot, base_link, tip_link)) {
+    if (joint->type() != Joint::Type::Fixed) {
+      joint_names_.push_back(joint->name());
+    }
+  }
+}
+
+/* ************************************************************************* */
+std::vector<Vector> AnalyticIK::inversePoint(const Point3 &,
+                                             const Point3 &) const {
+  throw std::runtime_error("AnalyticIK: no point solver for chain to " +
+                           tip_link_);
+}
+
+/* ************************************************************************* */
+std::vector<Vector> AnalyticIK::inversePose(const Pose3 &) const {
+  throw std::runtime_error("AnalyticIK: no pose solver for chain to " +
+                           tip_link_);
+}
+
+/* ************************************************************************* */
+// Solve A cos(x) + B sin(x) = C for x.
+static std::vector<double> SolveTrigonometric(double A, double B, double C) {
+  const double r = std::hypot(A, B);
+  if (r < 1e-12) return {};
+  const double ratio = C / r;
+  if (std::abs(ratio) > 1.0 + 1e-9) return {};
+  const double phi = std::atan2(B, A);
+  const double delta = std::acos(std::clamp(ratio, -1.0, 1.0));
+  if (delta < 1e-12) return {phi};
+  return {phi + delta, phi - delta};
+}
+
+// Wrap an angle to [-pi, pi).
+static double Wrap(double angle) {
+  return angle - 2 * M_PI * std::floor((angle + M_PI) / (2 * M_PI));
+}
+
+// Rotate a point about the axis through `point` with direction `axis`.
+static Point3 RotateAbout(const Vector3 &axis, const Point3 &point, double q,
+                          const Point3 &p) {
+  return point + gtsam::Rot3::Expmap(axis * q) * (p - point);
+}
+
+/* ************************************************************************* */
+ThreeDofLegIK::ThreeDofLegIK(const Robot &robot, const std::string &base_link,
+                             const std::string &tip_link)
+    : AnalyticIK(robot, base_link, tip_link) {
+  // Joint axes in the base frame with the leg at rest, from the screw axes.
+  Pose3 bTp;  // Pose of the parent link of the current joint.
+  for (auto &&joint : KinematicChain(robot, base_link, tip_link)) {
+    if (joint->type() == Joint::Type::Revolute) {
+      // pScrewAxis is negated: the child moves about -pScrewAxis with q.
+      const gtsam::Vector6 S = -joint->pScrewAxis();
+      const Vector3 w = S.head<3>(), v = S.tail<3>();
+      axes_.push_back(bTp.rotation() * w);
+      points_.push_back(bTp.transformFrom(Point3(w.cross(v))));
+      const auto &limits = joint->parameters().scalar_limits;
+      limits_.emplace_back(limits.value_lower_limit, limits.value_upper_limit);
+    } else if (joint->type() != Joint::Type::Fixed) {
+      throw std::invalid_argument("ThreeDofLegIK: joint " + joint->name() +
+                                  " is not revolute");
+    }
+    bTp = bTp * joint->parentTchild(0.0);
+  }
+  bTt_ = bTp;
+
+  if (axes_.size() != 3) {
+    throw std::invalid_argument("ThreeDofLegIK: chain to " + tip_link +
+                                " does not have three revolute joints");
+  }
+  sign_ = axes_[1].dot(axes_[2]);
+  if (std::abs(std::abs(sign_) - 1.0) > 1e-6) {
+    throw std::invalid_argument("ThreeDofLegIK: last two axes of chain to " +
+                                tip_link + " are not parallel");
+  }
+  sign_ = sign_ > 0 ? 1.0 : -1.0;
+  if (std::abs(axes_[0].dot(axes_[1])) > 1.0 - 1e-6) {
+    throw std::invalid_argument("ThreeDofLegIK: first axis of chain to " +
+                                tip_link + " is parallel to the others");
+  }
+}
+
+/* ************************************************************************* */
+Point3 ThreeDofLegIK::forwardPoint(const Vector &q,
+                                   const Point3 &point_in_tip) const {
+  Point3 p = bTt_.transformFrom(point_in_tip);
+  for (int i = 2; i >= 0; i--) p = RotateAbout(axes_[i], points_[i], q(i), p);
+  return p;
+}
+
+/* ************************************************************************* */
+std::vector<Vector> ThreeDofLegIK::inversePoint(
+    const Point3 &point_in_tip, const Point3 &goal_in_base) const {
+  const Vector3 &a = axes_[0], &b = axes_[1];
+  const Point3 f0 = bTt_.transformFrom(point_in_tip);
+
+  // Motion of the last two joints keeps the offset along their axis b, which
+  // the first joint has to match: (R(a, q1) b) . u = d.
+  const Vector3 u = goal_in_base - points_[0];
+  const double d = b.dot(f0 - points_[0]);
+  const double ab = a.dot(b);
+  const Vector3 b_perp = b - ab * a, c = a.cross(b);
+
+  // Project onto the plane of motion of the last two joints.
+  auto project = [&b](const Vector3 &v) -> Vector3 { return v - b.dot(v) * b; };
+  const Vector3 v1 = project(points_[2] - points_[1]);
+  const Vector3 v2 = project(f0 - points_[2]), bv2 = b.cross(v2);
+
+  std::vector<Vector> solutions;
+  for (double q1 : SolveTrigonometric(b_perp.dot(u), c.dot(u),
+                                      d - ab * a.dot(u))) {
+    // Goal in the frame of the first joint at rest, relative to the second.
+    const Point3 goal = RotateAbout(a, points_[0], -q1, goal_in_base);
+    const Vector3 t = project(goal - points_[1]);
+
+    // Planar two-link problem: |v1 + R(b, q) v2| = |t|.
+    const double C = 0.5 * (t.squaredNorm() - v1.squaredNorm() -
+                            v2.squaredNorm());
+    for (double q : SolveTrigonometric(v1.dot(v2), v1.dot(bv2), C)) {
+      const Vector3 w = v1 + std::cos(q) * v2 + std::sin(q) * bv2;
+      const double q2 = std::atan2(b.dot(w.cross(t)), w.dot(t));
+      Vector solution = Vector3(Wrap(q1), Wrap(q2), Wrap(sign_ * q));
+      if ((forwardPoint(solution, point_in_tip) - goal_in_base).norm() < 1e-6) {
+        solutions.push_back(solution);
+      }
+    }
+  }
+
+  // Solutions within the joint limits first, then the smallest.
+  auto within_limits = [this](const Vector &q) {
+    for (size_t i = 0; i < 3; i++) {
+      if (q(i) < limits_[i].first || q(i) > limits_[i].second) return false;
+    }
+    return true;
+  };
+  std::stable_sort(solutions.begin(), solutions.end(),
+                   [&](const Vector &q1, const Vector &q2) {
+                     const bool in1 = within_limits(q1),
+                                in2 = within_limits(q2);
+                     if (in1 != in2) return in1;
+                     return q1.norm() < q2.norm();
+                   });
+  return solutions;
+}
+
+/* ************************************************************************* */
+AnalyticIKRegistry AnalyticIKRegistry::Legs(const Robot &robot,
+                                            const std::string &base_link) {
+  AnalyticIKRegistry registry;
+  for (auto &&link : robot.links()) {
+    if (link->name() == base_link || link->joints().size() != 1) continue;
+    try {
+      registry.add(std::make_shared<ThreeDofLegIK>(robot, base_link,
+                                                   link->name()));
+    } catch (const std::invalid_argument &) {
+      // Not a leg with the supported structure.
+    }
+  }
+  return registry;
+}
+
+}  // namespace gtdynamics
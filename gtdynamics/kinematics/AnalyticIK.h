@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  AnalyticIK.h
+ * @brief Closed-form inverse kinematics for kinematic sub-chains of a robot.
+ */
+
+#pragma once
+
+#include <gtdynamics/universal_robot/Robot.h>
+#include <gtsam/base/Vector.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/geometry/Pose3.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gtdynamics {
+
+/**
+ * Return the joints on the path from the base link down to the tip link,
+ * including fixed joints, in order from base to tip.
+ * @throws std::invalid_argument if the tip is not a descendant of the base.
+ */
+std::vector<JointSharedPtr> KinematicChain(const Robot &robot,
+                                           const std::string &base_link,
+                                           const std::string &tip_link);
+
+/**
+ * Base class for closed-form inverse kinematics of a serial sub-chain of a
+ * robot, from a base link to a tip link. Solutions are joint angles of the
+ * non-fixed joints of the chain, in order from base to tip. All poses and
+ * points are expressed in link CoM frames, as elsewhere in GTDynamics.
+ */
+class AnalyticIK {
+ protected:
+  std::string base_link_, tip_link_;
+  std::vector<std::string> joint_names_;
+
+ public:
+  /**
+   * Constructor.
+   * @param robot the robot the chain is part of
+   * @param base_link name of the base link of the chain
+   * @param tip_link name of the tip link of the chain
+   */
+  AnalyticIK(const Robot &robot, const std::string &base_link,
+             const std::string &tip_link);
+
+  virtual ~AnalyticIK() {}
+
+  /// Name of the base link of the chain.
+  const std::string &baseLink() const { return base_link_; }
+
+  /// Name of the tip link of the chain.
+  const std::string &tipLink() const { return tip_link_; }
+
+  /// Names of the non-fixed joints of the chain, from base to tip.
+  const std::vector<std::string> &jointNames() const { return joint_names_; }
+
+  /**
+   * Joint angles such that a point on the tip link reaches a goal point.
+   * @param point_in_tip point in the tip link CoM frame
+   * @param goal_in_base goal for the point in the base link CoM frame
+   * @return all solutions, best first, or none if the goal is unreachable
+   */
+  virtual std::vector<gtsam::Vector> inversePoint(
+      const gtsam::Point3 &point_in_tip,
+      const gtsam::Point3 &goal_in_base) const;
+
+  /**
+   * Joint angles such that the tip link reaches a goal pose.
+   * @param bTt goal pose of the tip link CoM in the base link CoM frame
+   * @return all solutions, best first, or none if the goal is unreachable
+   */
+  virtual std::vector<gtsam::Vector> inversePose(
+      const gtsam::Pose3 &bTt) const;
+};
+
+/**
+ * Closed-form inverse kinematics for a leg with three revolute joints, where
+ * the last two axes are parallel, e.g., the hip abduction, hip and knee
+ * joints of the A1 and Vision60 legs. The geometry is read from the robot, so
+ * any leg with this structure is supported.
+ *
+ * The first joint angle is set by the offset of the goal along the parallel
+ * axes, which leaves a planar two-link problem for the other two. This gives
+ * up to four solutions, ordered by whether they are within the joint limits,
+ * and then by their norm.
+ */
+class ThreeDofLegIK : public AnalyticIK {
+  // Joint axes and points on the axes in the base frame, at rest.
+  std::vector<gtsam::Vector3> axes_;
+  std::vector<gtsam::Point3> points_;
+  gtsam::Pose3 bTt_;  // Tip pose in the base frame, at rest.
+  double sign_;       // +1 if the last two axes point the same way, else -1.
+  std::vector<std::pair<double, double>> limits_;
+
+ public:
+  /**
+   * Constructor.
+   * @throws std::invalid_argument if the chain does not have the structure.
+   */
+  ThreeDofLegIK(const Robot &robot, const std::string &base_link,
+                const std::string &tip_link);
+
+  /// Point on the tip link in the base frame, for the given joint angles.
+  gtsam::Point3 forwardPoint(const gtsam::Vector &q,
+                             const gtsam::Point3 &point_in_tip) const;
+
+  std::vector<gtsam::Vector> inversePoint(
+      const gtsam::Point3 &point_in_tip,
+      const gtsam::Point3 &goal_in_base) const override;
+};
+
+/**
+ * A set of analytic inverse kinematics solvers for a robot, keyed on the tip
+ * link of their chain.
+ */
+class AnalyticIKRegistry {
+  std::map<std::string, std::shared_ptr<const AnalyticIK>> solvers_;
+
+ public:
+  /// Add a solver, replacing any solver for the same tip link.
+  void add(const std::shared_ptr<const AnalyticIK> &solver) {
+    solvers_[solver->tipLink()] = solver;
+  }
+
+  /// Solver for the chain ending at the given link, or nullptr.
+  std::shared_ptr<const AnalyticIK> find(const std::string &tip_link) const {
+    auto it = solvers_.find(tip_link);
+    return it == solvers_.end() ? nullptr : it->second;
+  }
+
+  /// Number of solvers.
+  size_t size() const { return solvers_.size(); }
+
+  /**
+   * Registry with a ThreeDofLegIK for every leg of a legged robot, i.e., every
+   * chain from the base link to a leaf link with the supported structure.
+   */
+  static AnalyticIKRegistry Legs(const Robot &robot,
+                                 const std::string &base_link);
+};
+
+}  // namespace gtdynamics
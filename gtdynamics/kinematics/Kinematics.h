@@ -13,14 +13,20 @@
 
 #pragma once
 
+#include <gtdynamics/kinematics/AnalyticIK.h>
 #include <gtdynamics/optimizer/Optimizer.h>
 #include <gtdynamics/universal_robot/Robot.h>
 #include <gtdynamics/utils/Interval.h>
 #include <gtdynamics/utils/PointOnLink.h>
+#include <gtdynamics/utils/Slice.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/nonlinear/LevenbergMarquardtParams.h>
 
+#include <functional>
+#include <memory>
+#include <optional>
+
 namespace gtdynamics {
 
 /**
@@ -72,6 +78,18 @@ struct KinematicsParameters : public OptimizationParameters {
       g_cost_model,                            // goal point
       prior_q_cost_model;                      // joint angle prior factor
 
+  // Slices of an interval are solved on up to num_threads threads (0 for all
+  // hardware threads), or in sequence, each starting from the solution of the
+  // previous slice, if warm_start_slices is set.
+  size_t num_threads = 1;
+  bool warm_start_slices = false;
+
+  // Analytic solvers for the chains with contact goals. If set, they
+  // initialize inverse kinematics on a slice, or replace the numeric solve
+  // altogether if analytic_ik_only is set.
+  std::shared_ptr<const AnalyticIKRegistry> analytic_ik;
+  bool analytic_ik_only = false;
+
   // TODO(yetong): replace noise model with tolerance.
   KinematicsParameters()
       : p_cost_model(Isotropic::Sigma(6, 1e-4)),
@@ -169,6 +187,34 @@ class Kinematics : public Optimizer {
                         const ContactGoals& contact_goals,
                         bool contact_goals_as_constraints = true) const;
 
+  /**
+   * @fn Inverse kinematics on a single slice, from given initial values.
+   * @param slice Slice instance.
+   * @param robot Robot specification from URDF/SDF.
+   * @param contact_goals goals for contact points
+   * @param contact_goals_as_constraints treat contact goal as hard constraints
+   * @param initial_values initial poses and joint angles for the slice
+   * @returns values with poses and joint angles.
+   */
+  gtsam::Values inverse(const Slice& slice, const Robot& robot,
+                        const ContactGoals& contact_goals,
+                        bool contact_goals_as_constraints,
+                        const gtsam::Values& initial_values) const;
+
+  /**
+   * @fn Analytic inverse kinematics on a single slice, using the analytic
+   * solvers in the parameters. The base link of the solvers stays at its rest
+   * pose, and joints not in any solved chain are set to zero.
+   * @param slice Slice instance.
+   * @param robot Robot specification from URDF/SDF.
+   * @param contact_goals goals for contact points
+   * @returns values with poses and joint angles, or nothing if there is no
+   * solver for a goal, or no solution.
+   */
+  std::optional<gtsam::Values> analyticInverse(
+      const Slice& slice, const Robot& robot,
+      const ContactGoals& contact_goals) const;
+
   /**
    * Interpolate using inverse kinematics: the goals are linearly interpolated.
    * @param context Interval instance
@@ -181,5 +227,20 @@ class Kinematics : public Optimizer {
   gtsam::Values interpolate(const CONTEXT& context, const Robot& robot,
                             const ContactGoals& contact_goals1,
                             const ContactGoals& contact_goals2) const;
+
+ protected:
+  /**
+   * Inverse kinematics on every slice of an interval, concurrently or
+   * warm-started in sequence, as set in the parameters.
+   * @param interval Interval instance.
+   * @param robot Robot specification from URDF/SDF.
+   * @param contact_goals contact goals for a given time step
+   * @param contact_goals_as_constraints treat contact goal as hard constraints
+   * @returns values with poses and joint angles for all slices.
+   */
+  gtsam::Values inverseSlices(
+      const Interval& interval, const Robot& robot,
+      const std::function<ContactGoals(size_t)>& contact_goals,
+      bool contact_goals_as_constraints = true) const;
 };
 }  // namespace gtdynamics
@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  KinematicsFixedLagSmoother.cpp
+ * @brief Fixed-lag state estimation from joint encoders and contacts.
+ */
+
+#include <gtdynamics/factors/ContactPointFactor.h>
+#include <gtdynamics/factors/JointMeasurementFactor.h>
+#include <gtdynamics/factors/PreintegratedContactFactors.h>
+#include <gtdynamics/kinematics/KinematicsFixedLagSmoother.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <stdexcept>
+
+namespace gtdynamics {
+
+using gtsam::NonlinearFactorGraph;
+using gtsam::Pose3;
+using gtsam::Values;
+
+/* ************************************************************************* */
+KinematicsFixedLagSmoother::KinematicsFixedLagSmoother(
+    const Robot &robot, const std::string &base_name, const Pose3 &wTb0,
+    const KinematicsFixedLagSmootherParameters &parameters)
+    : robot_(robot),
+      base_link_(robot.link(base_name)),
+      p_(parameters),
+      optimizer_(parameters),
+      wTb_(wTb0) {}
+
+/* ************************************************************************* */
+gtsam::ISAM2Result KinematicsFixedLagSmoother::update(
+    const std::map<std::string, double> &joint_angles,
+    const PointOnLinks &contact_points, double dt) {
+  const size_t k = k_;
+  const int base_id = base_link_->id();
+  NonlinearFactorGraph graph;
+
+  // Predict the link poses with forward kinematics from the last base pose.
+  Values known;
+  InsertPose(&known, base_id, k, wTb_);
+  for (auto &&joint : robot_.joints()) {
+    const auto it = joint_angles.find(joint->name());
+    if (it == joint_angles.end()) {
+      throw std::invalid_argument(
+          "KinematicsFixedLagSmoother: no reading for joint " + joint->name());
+    }
+    InsertJointAngle(&known, joint->id(), k, it->second);
+    graph.emplace_shared<JointMeasurementFactor>(p_.encoder_model, joint,
+                                                 it->second, k);
+  }
+  const Values fk = robot_.forwardKinematics(known, k, base_link_->name());
+  Values new_values;
+  for (auto &&link : robot_.links()) {
+    InsertPose(&new_values, link->id(), k, Pose(fk, link->id(), k));
+  }
+
+  // Contact frames at the contact points, with the orientation of the link.
+  for (auto &&cp : contact_points) {
+    const gtsam::Key key = ContactPoseKey(cp.link->id(), k);
+    new_values.insert(key, Pose(fk, cp.link->id(), k) *
+                               Pose3(gtsam::Rot3(), cp.point));
+    graph.emplace_shared<ContactPoseFactor>(cp, key, p_.contact_pose_model, k);
+  }
+
+  // Base prior at the first step, random walk and contacts afterwards.
+  if (k == 0) {
+    graph.emplace_shared<gtsam::PriorFactor<Pose3>>(PoseKey(base_id, k), wTb_,
+                                                    p_.base_prior_model);
+  } else {
+    graph.emplace_shared<gtsam::BetweenFactor<Pose3>>(
+        PoseKey(base_id, k - 1), PoseKey(base_id, k), Pose3(),
+        p_.base_motion_model);
+    // A contact point that stays in contact barely moves over one step.
+    for (auto &&cp : contact_points) {
+      const int i = cp.link->id();
+      const auto wTc = contacts_.find(i);
+      if (wTc == contacts_.end()) continue;
+      const PreintegratedPointContactMeasurements pcm(
+          wTb_, wTc->second, dt, p_.contact_velocity_covariance);
+      graph.emplace_shared<PreintegratedPointContactFactor>(
+          PoseKey(base_id, k - 1), ContactPoseKey(i, k - 1),
+          PoseKey(base_id, k), ContactPoseKey(i, k), pcm);
+    }
+  }
+
+  const gtsam::ISAM2Result result = optimizer_.update(graph, new_values);
+  wTb_ = optimizer_.isam().calculateEstimate<Pose3>(PoseKey(base_id, k));
+  contacts_.clear();
+  for (auto &&cp : contact_points) {
+    const int i = cp.link->id();
+    contacts_[i] = optimizer_.isam().calculateEstimate<Pose3>(
+        ContactPoseKey(i, k));
+  }
+  k_ += 1;
+  return result;
+}
+
+}  // namespace gtdynamics
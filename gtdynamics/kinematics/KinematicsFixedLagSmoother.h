@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  KinematicsFixedLagSmoother.h
+ * @brief Fixed-lag state estimation from joint encoders and contacts.
+ */
+
+#pragma once
+
+#include <gtdynamics/optimizer/IncrementalOptimizer.h>
+#include <gtdynamics/universal_robot/Robot.h>
+#include <gtdynamics/utils/PointOnLink.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gtdynamics {
+
+/// Parameters for KinematicsFixedLagSmoother.
+struct KinematicsFixedLagSmootherParameters : public IncrementalParameters {
+  using Isotropic = gtsam::noiseModel::Isotropic;
+
+  /// Prior on the base pose at the first time step.
+  gtsam::SharedNoiseModel base_prior_model = Isotropic::Sigma(6, 1e-3);
+
+  /// Weak random walk on the base pose, for steps without contacts.
+  gtsam::SharedNoiseModel base_motion_model = Isotropic::Sigma(6, 1.0);
+
+  /// Noise on the link poses predicted from the joint encoders.
+  gtsam::SharedNoiseModel encoder_model = Isotropic::Sigma(6, 1e-4);
+
+  /// Noise tying a contact frame to the contact point on its link.
+  gtsam::SharedNoiseModel contact_pose_model = Isotropic::Sigma(6, 1e-4);
+
+  /// Covariance of the discrete velocity of a foot in contact.
+  gtsam::Matrix3 contact_velocity_covariance = gtsam::I_3x3 * 1e-2;
+
+  /**
+   * Constructor.
+   * @param _lag number of most recent time steps kept in the window
+   * @param _marginalization_stride number of time steps marginalized at once
+   */
+  KinematicsFixedLagSmootherParameters(size_t _lag = 20,
+                                       size_t _marginalization_stride = 5)
+      : IncrementalParameters(_lag, _marginalization_stride) {}
+};
+
+/**
+ * KinematicsFixedLagSmoother estimates the link poses of a legged robot at
+ * rate, over a sliding window of the most recent time steps.
+ *
+ * Every update adds one time step with a JointMeasurementFactor for every
+ * joint encoder reading, and a contact frame ContactPoseKey(i, k) at every
+ * contact point, tied to its link with a ContactPoseFactor. A foot that
+ * stays in contact since the previous time step adds a
+ * PreintegratedPointContactFactor between the base and contact frames of the
+ * two steps, which keeps the contact point in place up to the contact
+ * velocity noise. Contacts are preintegrated over a single step, rather than
+ * the whole contact phase, so that old time steps can be marginalized while a
+ * foot is still in contact. The problem is solved with
+ * iSAM2 and old time steps are marginalized as in IncrementalOptimizer,
+ * which bounds both the latency of an update and the memory use.
+ */
+class KinematicsFixedLagSmoother {
+ protected:
+  Robot robot_;
+  LinkSharedPtr base_link_;
+  KinematicsFixedLagSmootherParameters p_;
+  IncrementalOptimizer optimizer_;
+  gtsam::Pose3 wTb_;  // Base pose estimate at the last time step.
+  std::map<int, gtsam::Pose3> contacts_;  // Contact frames at the last step.
+  size_t k_ = 0;                          // Next time step.
+
+ public:
+  /**
+   * Constructor.
+   * @param robot the robot, with a floating base link
+   * @param base_name name of the base link
+   * @param wTb0 base pose at the first time step, used as prior
+   * @param parameters smoother parameters
+   */
+  KinematicsFixedLagSmoother(const Robot &robot, const std::string &base_name,
+                             const gtsam::Pose3 &wTb0,
+                             const KinematicsFixedLagSmootherParameters
+                                 &parameters = {});
+
+  /**
+   * Add the measurements at the next time step, and update the estimate.
+   *
+   * @param joint_angles encoder readings for all joints, by joint name
+   * @param contact_points contact points at this time step, at most one per
+   * link
+   * @param dt time since the previous time step
+   * @return the result of the iSAM2 update
+   */
+  gtsam::ISAM2Result update(const std::map<std::string, double> &joint_angles,
+                            const PointOnLinks &contact_points,
+                            double dt);
+
+  /// Number of time steps added so far.
+  size_t numSteps() const { return k_; }
+
+  /// Base pose estimate at the last time step.
+  const gtsam::Pose3 &basePose() const { return wTb_; }
+
+  /// Estimate of all link poses and contact frames in the window.
+  gtsam::Values estimate() const { return optimizer_.estimate(); }
+
+  /// The underlying incremental optimizer.
+  const IncrementalOptimizer &optimizer() const { return optimizer_; }
+};
+
+}  // namespace gtdynamics
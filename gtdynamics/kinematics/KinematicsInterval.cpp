@@ -13,10 +13,15 @@
 
 #include <gtdynamics/kinematics/Kinematics.h>
 #include <gtdynamics/utils/Interval.h>
+#include <gtdynamics/utils/Parallel.h>
 #include <gtdynamics/utils/Slice.h>
+#include <gtdynamics/utils/values.h>
 #include <gtsam/nonlinear/GaussNewtonOptimizer.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 
+#include <functional>
+#include <vector>
+
 namespace gtdynamics {
 
 using gtsam::NonlinearFactorGraph;
@@ -90,12 +95,9 @@ Values Kinematics::inverse<Interval>(const Interval& interval,
                                      const Robot& robot,
                                      const ContactGoals& contact_goals,
                                      bool contact_goals_as_constraints) const {
-  Values results;
-  for (size_t k = interval.k_start; k <= interval.k_end; k++) {
-    results.insert(
-        inverse(Slice(k), robot, contact_goals, contact_goals_as_constraints));
-  }
-  return results;
+  return inverseSlices(
+      interval, robot,
+      [&](size_t) { return contact_goals; }, contact_goals_as_constraints);
 }
 
 template <>
@@ -103,9 +105,8 @@ Values Kinematics::interpolate<Interval>(
     const Interval& interval, const Robot& robot,
     const ContactGoals& contact_goals1,
     const ContactGoals& contact_goals2) const {
-  Values result;
   const double dt = 1.0 / (interval.k_start - interval.k_end);  // 5 6 7 8 9 [10
-  for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+  return inverseSlices(interval, robot, [&](size_t k) {
     const double t = dt * (k - interval.k_start);
     ContactGoals goals;
     transform(contact_goals1.begin(), contact_goals1.end(),
@@ -115,9 +116,41 @@ Values Kinematics::interpolate<Interval>(
                     goal1.point_on_link,
                     (1.0 - t) * goal1.goal_point + t * goal2.goal_point};
               });
-    result.insert(inverse(Slice(k), robot, goals));
+    return goals;
+  });
+}
+
+Values Kinematics::inverseSlices(
+    const Interval& interval, const Robot& robot,
+    const std::function<ContactGoals(size_t)>& contact_goals,
+    bool contact_goals_as_constraints) const {
+  Values results;
+
+  // Warm-started slices depend on the previous one, so run them in sequence.
+  if (p_.warm_start_slices) {
+    Values previous;
+    for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+      const Slice slice(k);
+      const Values initial_values = previous.empty()
+                                        ? initialValues(slice, robot)
+                                        : ShiftValues(previous, 1);
+      previous = inverse(slice, robot, contact_goals(k),
+                         contact_goals_as_constraints, initial_values);
+      results.insert(previous);
+    }
+    return results;
   }
-  return result;
+
+  // Otherwise the slices are independent problems.
+  const size_t num_slices = interval.k_end - interval.k_start + 1;
+  std::vector<Values> slice_results(num_slices);
+  ParallelFor(num_slices, p_.num_threads, [&](size_t i) {
+    const size_t k = interval.k_start + i;
+    slice_results[i] = inverse(Slice(k), robot, contact_goals(k),
+                               contact_goals_as_constraints);
+  });
+  for (auto&& slice_result : slice_results) results.insert(slice_result);
+  return results;
 }
 
 }  // namespace gtdynamics
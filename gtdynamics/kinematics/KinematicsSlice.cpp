@@ -15,6 +15,7 @@
 #include <gtdynamics/factors/PoseFactor.h>
 #include <gtdynamics/kinematics/Kinematics.h>
 #include <gtdynamics/utils/Slice.h>
+#include <gtdynamics/utils/values.h>
 #include <gtsam/linear/Sampler.h>
 #include <gtsam/nonlinear/GaussNewtonOptimizer.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
@@ -139,6 +140,61 @@ template <>
 Values Kinematics::inverse<Slice>(const Slice& slice, const Robot& robot,
                                   const ContactGoals& contact_goals,
                                   bool contact_goals_as_constraints) const {
+  if (p_.analytic_ik) {
+    if (auto values = analyticInverse(slice, robot, contact_goals)) {
+      if (p_.analytic_ik_only) return *values;
+      return inverse(slice, robot, contact_goals, contact_goals_as_constraints,
+                     *values);
+    }
+  }
+  return inverse(slice, robot, contact_goals, contact_goals_as_constraints,
+                 initialValues(slice, robot));
+}
+
+std::optional<Values> Kinematics::analyticInverse(
+    const Slice& slice, const Robot& robot,
+    const ContactGoals& contact_goals) const {
+  if (!p_.analytic_ik || contact_goals.empty()) return {};
+
+  Values known;
+  std::optional<std::string> base_name;
+  for (const ContactGoal& goal : contact_goals) {
+    const auto solver = p_.analytic_ik->find(goal.link()->name());
+    if (!solver) return {};
+    const auto base = robot.link(solver->baseLink());
+    const auto solutions = solver->inversePoint(
+        goal.contactInCoM(), base->bMcom().transformTo(goal.goal_point));
+    if (solutions.empty()) return {};
+    const auto& joint_names = solver->jointNames();
+    for (size_t i = 0; i < joint_names.size(); i++) {
+      const auto key =
+          JointAngleKey(robot.joint(joint_names[i])->id(), slice.k);
+      if (known.exists(key)) return {};  // Two goals on the same chain.
+      known.insert(key, solutions.front()(i));
+    }
+    if (!base_name) {
+      base_name = base->name();
+      InsertPose(&known, base->id(), slice.k, base->bMcom());
+    }
+  }
+
+  // Forward kinematics for all link poses, with the other joints at zero.
+  Values values;
+  const Values fk = robot.forwardKinematics(known, slice.k, base_name);
+  for (auto&& joint : robot.joints()) {
+    const auto key = JointAngleKey(joint->id(), slice.k);
+    values.insert(key, known.exists(key) ? known.at<double>(key) : 0.0);
+  }
+  for (auto&& link : robot.links()) {
+    InsertPose(&values, link->id(), slice.k, Pose(fk, link->id(), slice.k));
+  }
+  return values;
+}
+
+Values Kinematics::inverse(const Slice& slice, const Robot& robot,
+                           const ContactGoals& contact_goals,
+                           bool contact_goals_as_constraints,
+                           const Values& initial_values) const {
   // Robot kinematics constraints
   auto constraints = this->constraints(slice, robot);
   NonlinearFactorGraph graph;
@@ -157,8 +213,6 @@ Values Kinematics::inverse<Slice>(const Slice& slice, const Robot& robot,
   // graph.addPrior<gtsam::Pose3>(PoseKey(0, slice.k),
   // gtsam::Pose3(), nullptr);
 
-  auto initial_values = initialValues(slice, robot);
-
   return optimize(graph, constraints, initial_values);
 }
 }  // namespace gtdynamics
@@ -12,10 +12,13 @@
  */
 
 #include <gtdynamics/manifold/ConstraintManifold.h>
+#include <gtdynamics/utils/Parallel.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 
+#include <optional>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -133,4 +136,37 @@ const Values ConstraintManifold::feasibleValues() const {
   return optimizer.optimize();
 }
 
+/* ************************************************************************* */
+Values RetractConstraintManifolds(const Values &values,
+                                  const VectorValues &delta,
+                                  size_t num_threads) {
+  // Retract the other variables as usual, and collect the manifolds.
+  KeyVector manifold_keys;
+  VectorValues base_delta;
+  for (const auto &it : delta) {
+    const Key &key = it.first;
+    if (dynamic_cast<const GenericValue<ConstraintManifold> *>(
+            &values.at(key))) {
+      manifold_keys.push_back(key);
+    } else {
+      base_delta.insert(key, it.second);
+    }
+  }
+  Values new_values = values.retract(base_delta);
+
+  // Each manifold has its own retractor and basis, so they can be retracted
+  // concurrently.
+  std::vector<std::optional<ConstraintManifold>> manifolds(
+      manifold_keys.size());
+  gtdynamics::ParallelFor(manifolds.size(), num_threads, [&](size_t i) {
+    const Key &key = manifold_keys[i];
+    manifolds[i] =
+        values.at<ConstraintManifold>(key).retract(delta.at(key));
+  });
+  for (size_t i = 0; i < manifolds.size(); i++) {
+    new_values.update(manifold_keys[i], *manifolds[i]);
+  }
+  return new_values;
+}
+
 }  // namespace gtsam
@@ -170,6 +170,15 @@ class ConstraintManifold {
       size_t manifold_dim);
 };
 
+/** Retract values by delta as Values::retract does, but retract the constraint
+ * manifold variables, which are independent of each other, on up to
+ * num_threads threads (0 for all hardware threads). Each retraction also
+ * constructs the tangent space basis at the new values. The result does not
+ * depend on the number of threads. */
+Values RetractConstraintManifolds(const Values &values,
+                                  const VectorValues &delta,
+                                  size_t num_threads = 1);
+
 // Specialize ConstraintManifold traits to use a Retract/Local
 template <>
 struct traits<ConstraintManifold>
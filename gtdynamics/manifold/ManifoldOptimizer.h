@@ -33,6 +33,10 @@ struct ManifoldOptimizerParameters
                                // connected component.
   bool retract_final = false;  // Perform retraction on manifolds after
                                // optimization, used for infeasible methods.
+  size_t num_threads = 1;      // Number of threads used to construct and
+                               // retract the independent constraint
+                               // manifolds and to linearize the factors, 0
+                               // for all hardware threads.
   /// Default Constructor.
   ManifoldOptimizerParameters();
 };
@@ -14,8 +14,12 @@
 #include <gtdynamics/manifold/ConstraintManifold.h>
 #include <gtdynamics/manifold/ManifoldOptimizerType1.h>
 #include <gtdynamics/manifold/SubstituteFactor.h>
+#include <gtdynamics/optimizer/MutableLMOptimizer.h>
+#include <gtdynamics/utils/Parallel.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 
+#include <optional>
+
 #include "manifold/Retractor.h"
 #include "manifold/TspaceBasis.h"
 
@@ -38,10 +42,17 @@ Values ManifoldOptimizerType1::optimize(
   auto nonlinear_optimizer = constructNonlinearOptimizer(mopt_problem);
   auto nopt_values = nonlinear_optimizer->optimize();
   if (intermediate_result) {
-    intermediate_result->num_iters.push_back(
-        std::dynamic_pointer_cast<LevenbergMarquardtOptimizer>(
-            nonlinear_optimizer)
-            ->getInnerIterations());
+    if (auto lm_optimizer =
+            std::dynamic_pointer_cast<MutableLMOptimizer>(
+                nonlinear_optimizer)) {
+      intermediate_result->num_iters.push_back(
+          lm_optimizer->getInnerIterations());
+    } else {
+      intermediate_result->num_iters.push_back(
+          std::dynamic_pointer_cast<LevenbergMarquardtOptimizer>(
+              nonlinear_optimizer)
+              ->getInnerIterations());
+    }
   }
   return baseValues(mopt_problem, nopt_values);
 }
@@ -58,14 +69,26 @@ Values ManifoldOptimizerType1::baseValues(
   for (const Key& key : mopt_problem.unconstrained_keys_) {
     base_values.insert(key, nopt_values.at(key));
   }
-  for (const Key& key : mopt_problem.manifold_keys_) {
-    if (p_.retract_final) {
-      base_values.insert(
-          nopt_values.at(key).cast<ConstraintManifold>().feasibleValues());
-    } else {
+  if (!p_.retract_final) {
+    for (const Key& key : mopt_problem.manifold_keys_) {
       base_values.insert(
           nopt_values.at(key).cast<ConstraintManifold>().values());
     }
+    return base_values;
+  }
+
+  // Project each manifold onto its constraints, independently.
+  const KeyVector manifold_keys(mopt_problem.manifold_keys_.begin(),
+                                mopt_problem.manifold_keys_.end());
+  std::vector<Values> feasible_values(manifold_keys.size());
+  gtdynamics::ParallelFor(
+      manifold_keys.size(), p_.num_threads, [&](size_t i) {
+        feasible_values[i] = nopt_values.at(manifold_keys[i])
+                                 .cast<ConstraintManifold>()
+                                 .feasibleValues();
+      });
+  for (const Values& values : feasible_values) {
+    base_values.insert(values);
   }
   return base_values;
 }
@@ -102,17 +125,26 @@ void ManifoldOptimizerType1::constructMoptValues(
 void ManifoldOptimizerType1::constructManifoldValues(
     const EqConsOptProblem& ecopt_problem,
     ManifoldOptProblem& mopt_problem) const {
-  for (size_t i = 0; i < mopt_problem.components_.size(); i++) {
+  // The components are independent, so their manifolds, including the
+  // initial retraction and the tangent space basis, are constructed
+  // concurrently.
+  const auto& components = mopt_problem.components_;
+  std::vector<std::optional<ConstraintManifold>> manifolds(components.size());
+  gtdynamics::ParallelFor(components.size(), p_.num_threads, [&](size_t i) {
     // Find the values of variables in the component.
-    const auto& component = mopt_problem.components_.at(i);
-    const Key& component_key = *component->keys_.begin();
+    const auto& component = components.at(i);
     Values component_values;
     for (const Key& key : component->keys_) {
       component_values.insert(key, ecopt_problem.values_.at(key));
     }
     // Construct manifold value
-    auto constraint_manifold = ConstraintManifold(
-        component, component_values, p_.cc_params, p_.retract_init);
+    manifolds[i].emplace(component, component_values, p_.cc_params,
+                         p_.retract_init);
+  });
+
+  for (size_t i = 0; i < components.size(); i++) {
+    const Key& component_key = *components.at(i)->keys_.begin();
+    const auto& constraint_manifold = *manifolds[i];
     // check if the manifold is fully constrained
     if (constraint_manifold.dim() > 0) {
       mopt_problem.values_.insert(component_key, constraint_manifold);
@@ -193,6 +225,20 @@ ManifoldOptimizerType1::constructNonlinearOptimizer(
     return std::make_shared<GaussNewtonOptimizer>(
         mopt_problem.graph_, mopt_problem.values_,
         std::get<GaussNewtonParams>(nopt_params_));
+  } else if (std::holds_alternative<LevenbergMarquardtParams>(nopt_params_) &&
+             gtdynamics::NumThreads(p_.num_threads) > 1) {
+    // Same iterations as LevenbergMarquardtOptimizer, but linearize the
+    // factors and retract the manifolds concurrently.
+    auto optimizer = std::make_shared<MutableLMOptimizer>(
+        mopt_problem.graph_, mopt_problem.values_,
+        std::get<LevenbergMarquardtParams>(nopt_params_));
+    const size_t num_threads = p_.num_threads;
+    optimizer->setNumThreads(num_threads);
+    optimizer->setRetractFunction(
+        [num_threads](const Values& values, const VectorValues& delta) {
+          return RetractConstraintManifolds(values, delta, num_threads);
+        });
+    return optimizer;
   } else if (std::holds_alternative<LevenbergMarquardtParams>(nopt_params_)) {
     return std::make_shared<LevenbergMarquardtOptimizer>(
         mopt_problem.graph_, mopt_problem.values_,
@@ -60,10 +60,6 @@ MatrixBasis::MatrixBasis(const TspaceBasisParams::shared_ptr &params,
     : TspaceBasis(params) {
   auto linear_graph = cc->merit_graph_.linearize(values);
   JacobianFactor combined(*linear_graph);
-  auto augmented = combined.augmentedJacobian();
-  Matrix A = augmented.leftCols(augmented.cols() - 1); // m x n
-  Eigen::FullPivLU<Eigen::MatrixXd> lu(A);
-  basis_ = lu.kernel(); // n x n-m
   size_t position = 0;
   for (const Key &key : combined.keys()) {
     size_t var_dim = values.at(key).dim();
@@ -71,19 +67,36 @@ MatrixBasis::MatrixBasis(const TspaceBasisParams::shared_ptr &params,
     var_location_[key] = position;
     position += var_dim;
   }
+  computeBasis(combined, values);
   total_basis_dim_ = basis_.cols();
-  is_constructed_ = true;
 }
 
 /* ************************************************************************* */
 void MatrixBasis::construct(const ConnectedComponent::shared_ptr &cc,
                             const Values &values) {
+  if (isConstructedAt(values)) return;
   auto linear_graph = cc->merit_graph_.linearize(values);
-  JacobianFactor combined(*linear_graph);
+  computeBasis(JacobianFactor(*linear_graph), values);
+}
+
+/* ************************************************************************* */
+void MatrixBasis::computeBasis(const JacobianFactor &combined,
+                               const Values &values) {
   auto augmented = combined.augmentedJacobian();
   Matrix A = augmented.leftCols(augmented.cols() - 1); // m x n
   Eigen::FullPivLU<Eigen::MatrixXd> lu(A);
   basis_ = lu.kernel(); // n x n-m
+
+  // A non-trivial kernel has full column rank and contains a permuted identity
+  // block, so B^T B >= I and the pseudo-inverse (B^T B)^-1 B^T is well
+  // conditioned. A trivial kernel is returned as a zero column.
+  if (lu.dimensionOfKernel() == 0) {
+    basis_pinv_ = Matrix::Zero(basis_.cols(), basis_.rows());
+  } else {
+    basis_pinv_ =
+        (basis_.transpose() * basis_).llt().solve(basis_.transpose());
+  }
+  basis_values_ = values;
   is_constructed_ = true;
 }
 
@@ -106,15 +119,13 @@ Matrix MatrixBasis::recoverJacobian(const Key &key) const {
 /* ************************************************************************* */
 Vector MatrixBasis::localCoordinates(const Values &values,
                                      const Values &values_other) const {
-  Eigen::MatrixXd basis_pinv =
-      basis_.completeOrthogonalDecomposition().pseudoInverse();
   VectorValues delta = values.localCoordinates(values_other);
   Vector xi_base = Vector::Zero(values.dim());
   for (const auto &it : delta) {
     const Key &key = it.first;
     xi_base.middleRows(var_location_.at(key), var_dim_.at(key)) = it.second;
   }
-  Vector xi = basis_pinv * xi_base;
+  Vector xi = basis_pinv_ * xi_base;
   return xi;
 }
 
@@ -158,12 +169,37 @@ void SparseMatrixBasis::construct(const ConnectedComponent::shared_ptr &cc,
   A.setFromTriplets(triplet_list.begin(), triplet_list.end());
   is_constructed_ = true;
 
-  SpMatrix A_t = A.transpose();
-  SpMatrix Q;
-  auto qr = Eigen::SparseQR<SpMatrix, Eigen::COLAMDOrdering<int>>(A_t);
-  Q = qr.matrixQ();
-
-  basis_ = Q.rightCols(total_basis_dim_);
+  // Rank-revealing QR with a fill-reducing column ordering, A P = Q [R1 R2],
+  // with R1 upper triangular of size rank. Q is never formed: the kernel is
+  // P [-R1^-1 R2; I], which only needs a sparse triangular solve.
+  Eigen::SparseQR<SpMatrix, Eigen::COLAMDOrdering<int>> qr(A);
+  const size_t rank = qr.rank();
+  total_basis_dim_ = total_variable_dim_ - rank;
+  const SpMatrix R = qr.matrixR();
+  const SpMatrix R1 = R.topLeftCorner(rank, rank);
+  const SpMatrix R2 = R.topRightCorner(rank, total_basis_dim_);
+  SpMatrix X = R2;
+  R1.triangularView<Eigen::Upper>().solveInPlace(X);
+
+  std::vector<Triplet> kernel_triplets;
+  kernel_triplets.reserve(X.nonZeros() + total_basis_dim_);
+  for (int k = 0; k < X.outerSize(); ++k) {
+    for (SpMatrix::InnerIterator it(X, k); it; ++it) {
+      kernel_triplets.emplace_back(it.row(), it.col(), -it.value());
+    }
+  }
+  for (size_t i = 0; i < total_basis_dim_; i++) {
+    kernel_triplets.emplace_back(rank + i, i, 1.0);
+  }
+  SpMatrix kernel(total_variable_dim_, total_basis_dim_);
+  kernel.setFromTriplets(kernel_triplets.begin(), kernel_triplets.end());
+  basis_ = qr.colsPermutation() * kernel;
+
+  // The rows of the free variables form the identity.
+  free_locations_.resize(total_basis_dim_);
+  for (size_t i = 0; i < total_basis_dim_; i++) {
+    free_locations_[i] = qr.colsPermutation().indices()(rank + i);
+  }
 }
 
 /* ************************************************************************* */
@@ -185,7 +221,19 @@ Matrix SparseMatrixBasis::recoverJacobian(const Key &key) const {
 /* ************************************************************************* */
 Vector SparseMatrixBasis::localCoordinates(const Values &values,
                                            const Values &values_other) const {
-  return Vector::Zero(total_basis_dim_);
+  VectorValues delta = values.localCoordinates(values_other);
+  Vector xi_base = Vector::Zero(total_variable_dim_);
+  for (const auto &it : delta) {
+    const Key &key = it.first;
+    xi_base.middleRows(var_location_.at(key), var_dim_.at(key)) = it.second;
+  }
+
+  // The basis is the identity on the free variables.
+  Vector xi(total_basis_dim_);
+  for (size_t i = 0; i < total_basis_dim_; i++) {
+    xi(i) = xi_base(free_locations_[i]);
+  }
+  return xi;
 }
 
 /* ************************************************************************* */
@@ -197,6 +245,7 @@ void SparseMatrixBasis::setMatrix(const Matrix &matrix,
   for (size_t i = 0, nRows = matrix.rows(), nCols = matrix.cols(); i < nRows;
        ++i) {
     for (size_t j = 0; j < nCols; ++j) {
+      if (matrix(i, j) == 0.0) continue;
       triplet_list.emplace_back(i + row_offset, j + col_offset, matrix(i, j));
     }
   }
@@ -18,6 +18,7 @@
 #include <gtdynamics/manifold/MultiJacobian.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/inference/Key.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/VectorValues.h>
 
 #include <Eigen/Sparse>
@@ -179,7 +180,9 @@ class MatrixBasis : public TspaceBasis {
   std::map<Key, size_t> var_location_;  // location of variables in Jacobian
   std::map<Key, size_t> var_dim_;       // dimension of variables
   size_t total_basis_dim_;
-  gtsam::Matrix basis_;  // basis for the tangent space
+  gtsam::Matrix basis_;       // basis for the tangent space
+  gtsam::Matrix basis_pinv_;  // pseudo-inverse of the basis
+  Values basis_values_;       // values at which the basis was constructed
 
  public:
   /** Constructor
@@ -189,14 +192,20 @@ class MatrixBasis : public TspaceBasis {
   MatrixBasis(const TspaceBasisParams::shared_ptr &params,
               const ConnectedComponent::shared_ptr &cc, const Values &values);
 
-  /// Constructor from other, avoids recomputation.
+  /// Constructor from other, avoids recomputation. The basis of other is
+  /// reused if it was constructed at the same values.
   MatrixBasis(const ConnectedComponent::shared_ptr &cc, const Values &values,
               const MatrixBasis &other)
       : TspaceBasis(other.params_),
         var_location_(other.var_location_),
         var_dim_(other.var_dim_),
         total_basis_dim_(other.total_basis_dim_) {
-    if (params_->always_construct_basis) {
+    if (other.isConstructedAt(values)) {
+      basis_ = other.basis_;
+      basis_pinv_ = other.basis_pinv_;
+      basis_values_ = other.basis_values_;
+      is_constructed_ = true;
+    } else if (params_->always_construct_basis) {
       construct(cc, values);
     }
   }
@@ -224,7 +233,16 @@ class MatrixBasis : public TspaceBasis {
   /// Basis matrix.
   const Matrix &matrix() const { return basis_; }
 
-  /// Construct the actual basis, all the heavy computation goes here.
+  /// Pseudo-inverse of the basis matrix.
+  const Matrix &pseudoInverse() const { return basis_pinv_; }
+
+  /// Return if the basis is constructed at exactly the given values.
+  bool isConstructedAt(const Values &values) const {
+    return is_constructed_ && values.equals(basis_values_, 0.0);
+  }
+
+  /// Construct the actual basis, all the heavy computation goes here. Nothing
+  /// is recomputed if the basis is already constructed at the same values.
   void construct(const ConnectedComponent::shared_ptr &cc,
                  const Values &values) override;
 
@@ -232,10 +250,16 @@ class MatrixBasis : public TspaceBasis {
       const gtsam::KeyFormatter &keyFormatter = DefaultKeyFormatter) override {
     std::cout << "Matrix basis\n" << matrix() << "\n";
   }
+
+ protected:
+  /// Compute the basis and its pseudo-inverse from the linearized constraints.
+  void computeBasis(const JacobianFactor &combined, const Values &values);
 };
 
-/** Tangent space basis implmented using a matrix, e.g., the kernel of Dh(X),
- * where h(X)=0 represents all the constraints. */
+/** Tangent space basis implmented using a sparse matrix, the kernel of Dh(X),
+ * where h(X)=0 represents all the constraints. The kernel is computed with a
+ * rank-revealing sparse QR of Dh(X), and is the identity on a subset of
+ * (scalar) free variables, which also give the local coordinates. */
 class SparseMatrixBasis : public TspaceBasis {
  public:
   typedef Eigen::SparseMatrix<double> SpMatrix;
@@ -248,6 +272,7 @@ class SparseMatrixBasis : public TspaceBasis {
   size_t total_constraint_dim_;
   size_t total_basis_dim_;
   SpMatrix basis_;  // basis for the tangent space
+  std::vector<size_t> free_locations_;  // rows of basis_ that form identity
 
  public:
   /** Constructor
@@ -12,6 +12,7 @@
  */
 
 #include <gtdynamics/optimizer/AugmentedLagrangianOptimizer.h>
+#include <gtdynamics/optimizer/MutableLMOptimizer.h>
 
 namespace gtdynamics {
 
@@ -57,23 +58,28 @@ gtsam::Values AugmentedLagrangianOptimizer::optimize(
     z.push_back(gtsam::Vector::Zero(constraint->dim()));
   }
 
+  // Construct merit function once, updating the penalty parameter and the
+  // biases of the constraint factors in place.
+  gtsam::NonlinearFactorGraph merit_graph = graph;
+  auto merit_factors = CreateMeritFactors(constraints);
+  for (const auto& factor : merit_factors) {
+    merit_graph.add(factor);
+  }
+  gtsam::MutableLMOptimizer optimizer(merit_graph, p_.lm_parameters);
+  optimizer.setNumThreads(p_.linearize_threads);
+
   // Solve the constrained optimization problem by solving a sequence of
   // unconstrained optimization problems.
   for (int i = 0; i < p_.num_iterations; i++) {
-    // Construct merit function.
-    gtsam::NonlinearFactorGraph merit_graph = graph;
-
-    // Create factors corresponding to penalty terms of constraints.
     for (size_t constraint_index = 0; constraint_index < constraints.size();
          constraint_index++) {
-      auto constraint = constraints.at(constraint_index);
-      gtsam::Vector bias = z[constraint_index] / mu;
-      merit_graph.add(constraint->createFactor(mu, bias));
+      auto& factor = merit_factors[constraint_index];
+      factor->setPenalty(mu);
+      factor->setBias(z[constraint_index] / mu);
     }
 
     // Run LM optimization.
-    gtsam::LevenbergMarquardtOptimizer optimizer(merit_graph, values,
-                                                 p_.lm_parameters);
+    optimizer.setValues(values);
     auto result = optimizer.optimize();
 
     // Update parameters.
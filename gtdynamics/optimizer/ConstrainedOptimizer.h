@@ -24,6 +24,7 @@ namespace gtdynamics {
 /// Constrained optimization parameters shared between all solvers.
 struct ConstrainedOptimizationParameters {
   gtsam::LevenbergMarquardtParams lm_parameters;  // LM parameters
+  size_t linearize_threads = 1;  // threads to linearize with, 0 for all
 
   /// Constructor.
   ConstrainedOptimizationParameters() {}
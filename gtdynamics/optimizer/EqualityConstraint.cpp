@@ -93,6 +93,18 @@ EqualityConstraints ConstraintsFromGraph(
   return constraints;
 }
 
+/* ************************************************************************* */
+std::vector<gtsam::BiasedFactor::shared_ptr> CreateMeritFactors(
+    const EqualityConstraints& constraints) {
+  std::vector<gtsam::BiasedFactor::shared_ptr> factors;
+  factors.reserve(constraints.size());
+  for (const auto& constraint : constraints) {
+    factors.push_back(std::make_shared<gtsam::BiasedFactor>(
+        constraint->createFactor(1.0), gtsam::Vector::Zero(constraint->dim())));
+  }
+  return factors;
+}
+
 /* ************************************************************************* */
 size_t EqualityConstraints::dim() const {
   size_t dimension = 0;
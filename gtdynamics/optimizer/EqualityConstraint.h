@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <gtdynamics/factors/BiasedFactor.h>
 #include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
@@ -220,6 +221,16 @@ class EqualityConstraints : public std::vector<EqualityConstraint::shared_ptr> {
 EqualityConstraints ConstraintsFromGraph(
     const gtsam::NonlinearFactorGraph& graph);
 
+/**
+ * Create one merit factor per constraint, equal to createFactor(1.0) but with
+ * a penalty parameter and a bias that can be updated in place, with
+ * BiasedFactor::setPenalty and BiasedFactor::setBias. This allows to build a
+ * merit graph once and reuse it across the outer iterations of penalty and
+ * augmented Lagrangian methods.
+ */
+std::vector<gtsam::BiasedFactor::shared_ptr> CreateMeritFactors(
+    const EqualityConstraints& constraints);
+
 }  // namespace gtdynamics
 
 #include <gtdynamics/optimizer/EqualityConstraint-inl.h>
@@ -0,0 +1,72 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  IncrementalOptimizer.cpp
+ * @brief Incremental trajectory optimization with iSAM2.
+ */
+
+#include <gtdynamics/optimizer/IncrementalOptimizer.h>
+#include <gtdynamics/utils/DynamicsSymbol.h>
+
+#include <algorithm>
+
+namespace gtdynamics {
+
+using gtsam::Key;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+/* ************************************************************************* */
+gtsam::ISAM2Result IncrementalOptimizer::update(
+    const NonlinearFactorGraph &new_factors, const Values &new_values) {
+  for (const Key &key : new_values.keys()) {
+    if (static_keys_.count(key)) continue;
+    const uint64_t k = DynamicsSymbol(key).time();
+    k_start_ = k_start_ ? std::min(*k_start_, k) : k;
+    k_end_ = k_end_ ? std::max(*k_end_, k) : k;
+  }
+
+  // Marginalize once the window exceeds the lag by the stride.
+  const size_t lag = incremental_parameters_.lag;
+  const size_t stride =
+      std::max<size_t>(incremental_parameters_.marginalization_stride, 1);
+  if (lag == 0 || !k_end_ || *k_end_ + 1 < lag + stride ||
+      *k_start_ > *k_end_ + 1 - lag - stride) {
+    return isam_.update(new_factors, new_values);
+  }
+  const uint64_t k_new_start = *k_end_ + 1 - lag;
+
+  // Variables eliminated first are leaves of the Bayes tree, so eliminate the
+  // whole window with all marginalized variables ordered first.
+  gtsam::ISAM2UpdateParams update_params;
+  gtsam::FastMap<Key, int> constrained_keys;
+  gtsam::FastList<Key> reelim_keys, marginalized_keys;
+  auto add_key = [&](Key key) {
+    if (!static_keys_.count(key) && DynamicsSymbol(key).time() < k_new_start) {
+      constrained_keys[key] = 0;
+      marginalized_keys.push_back(key);
+    } else {
+      constrained_keys[key] = 1;
+    }
+  };
+  for (const Key &key : isam_.getLinearizationPoint().keys()) {
+    reelim_keys.push_back(key);
+    add_key(key);
+  }
+  for (const Key &key : new_values.keys()) add_key(key);
+  update_params.constrainedKeys = constrained_keys;
+  update_params.extraReelimKeys = reelim_keys;
+
+  gtsam::ISAM2Result result =
+      isam_.update(new_factors, new_values, update_params);
+  isam_.marginalizeLeaves(marginalized_keys);
+  k_start_ = k_new_start;
+  return result;
+}
+
+}  // namespace gtdynamics
@@ -0,0 +1,104 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  IncrementalOptimizer.h
+ * @brief Incremental trajectory optimization with iSAM2.
+ */
+
+#pragma once
+
+#include <gtdynamics/optimizer/Optimizer.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <optional>
+
+namespace gtdynamics {
+
+/// Parameters for incremental optimization.
+struct IncrementalParameters : public OptimizationParameters {
+  gtsam::ISAM2Params isam_parameters;  // iSAM2 parameters
+
+  /// Number of most recent time steps to keep, 0 keeps all time steps.
+  size_t lag = 0;
+
+  /**
+   * Number of time steps to marginalize at once. Marginalization re-eliminates
+   * the whole window, so it is amortized over this many time steps.
+   */
+  size_t marginalization_stride = 1;
+
+  IncrementalParameters() = default;
+
+  IncrementalParameters(size_t _lag, size_t _marginalization_stride = 1)
+      : lag(_lag), marginalization_stride(_marginalization_stride) {}
+};
+
+/**
+ * IncrementalOptimizer solves a trajectory optimization problem that grows
+ * over time, e.g., when new time slices from DynamicsGraph::dynamicsFactorGraph
+ * and DynamicsGraph::collocationFactors, or new contact goals, arrive while
+ * replanning online. Factors are added to iSAM2, which only relinearizes and
+ * re-eliminates the variables affected by the new factors.
+ *
+ * To keep long-running gaits from growing the problem without bound, all
+ * variables older than the `lag` most recent time steps are marginalized out
+ * once `marginalization_stride` time steps have accumulated. The time step of
+ * a variable is given by its DynamicsSymbol. Keys that do not encode a time
+ * step, e.g., phase durations, must be passed as static keys, and are never
+ * marginalized.
+ */
+class IncrementalOptimizer : public Optimizer {
+ protected:
+  const IncrementalParameters incremental_parameters_;
+  gtsam::KeySet static_keys_;
+  gtsam::ISAM2 isam_;
+  std::optional<uint64_t> k_start_;  // Oldest time step in the window.
+  std::optional<uint64_t> k_end_;    // Most recent time step in the window.
+
+ public:
+  /**
+   * Constructor.
+   * @param parameters incremental optimization parameters
+   * @param static_keys keys that do not encode a time step
+   */
+  explicit IncrementalOptimizer(
+      const IncrementalParameters &parameters = IncrementalParameters(),
+      const gtsam::KeySet &static_keys = {})
+      : Optimizer(parameters),
+        incremental_parameters_(parameters),
+        static_keys_(static_keys),
+        isam_(parameters.isam_parameters) {}
+
+  /**
+   * Add new factors and initial values for the new variables, and update the
+   * estimate. Old time steps are marginalized according to the lag.
+   *
+   * @param new_factors factors to add, e.g., the graph of a new time slice
+   * @param new_values initial values for variables not yet in the problem
+   * @return the result of the iSAM2 update
+   */
+  gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph &new_factors,
+                            const gtsam::Values &new_values);
+
+  /// Current estimate of all variables in the window.
+  gtsam::Values estimate() const { return isam_.calculateEstimate(); }
+
+  /// Oldest time step in the window, if any variables were added.
+  std::optional<uint64_t> startTime() const { return k_start_; }
+
+  /// Most recent time step in the window, if any variables were added.
+  std::optional<uint64_t> endTime() const { return k_end_; }
+
+  /// The underlying iSAM2 instance.
+  const gtsam::ISAM2 &isam() const { return isam_; }
+};
+
+}  // namespace gtdynamics
@@ -20,15 +20,19 @@
  */
 
 #include <gtdynamics/optimizer/MutableLMOptimizer.h>
+#include <gtdynamics/utils/Parallel.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/internal/LevenbergMarquardtState.h>
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -42,6 +46,42 @@ namespace gtsam {
 
 typedef internal::LevenbergMarquardtState State;
 
+namespace {
+/// Return true if both graphs have factors on the same keys, in order.
+bool SameStructure(const NonlinearFactorGraph& a,
+                   const NonlinearFactorGraph& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (!a[i] || !b[i]) {
+      if (a[i] != b[i]) return false;
+    } else if (a[i]->keys() != b[i]->keys()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Keys of every factor of a linear graph, empty for null factors.
+std::vector<KeyVector> FactorKeys(const GaussianFactorGraph& gfg) {
+  std::vector<KeyVector> keys;
+  keys.reserve(gfg.size());
+  for (const auto& factor : gfg) {
+    keys.push_back(factor ? factor->keys() : KeyVector());
+  }
+  return keys;
+}
+
+/// Return true if the damped system has factors on the given keys, in order.
+bool SameStructure(const std::vector<KeyVector>& keys,
+                   const GaussianFactorGraph& gfg) {
+  if (keys.size() != gfg.size()) return false;
+  for (size_t i = 0; i < gfg.size(); i++) {
+    if (gfg[i] ? gfg[i]->keys() != keys[i] : !keys[i].empty()) return false;
+  }
+  return true;
+}
+}  // namespace
+
 /* ************************************************************************* */
 MutableLMOptimizer::MutableLMOptimizer(const NonlinearFactorGraph& graph,
                                        const Values& initialValues,
@@ -81,7 +121,36 @@ int MutableLMOptimizer::getInnerIterations() const {
 
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr MutableLMOptimizer::linearize() const {
-  return graph_.linearize(state_->values);
+  const size_t num_factors = graph_.size();
+  const size_t num_threads =
+      std::min(gtdynamics::NumThreads(num_threads_), num_factors);
+  if (num_threads <= 1) return graph_.linearize(state_->values);
+
+  gttic(linearize_parallel);
+  // Preallocate one slot per factor, so every block writes its own slots and
+  // the factors keep their order.
+  auto linear = std::make_shared<GaussianFactorGraph>();
+  linear->resize(num_factors);
+  const Values& values = state_->values;
+  gtdynamics::ParallelFor(num_threads, num_threads, [&](size_t b) {
+    const size_t begin = num_factors * b / num_threads;
+    const size_t end = num_factors * (b + 1) / num_threads;
+    for (size_t i = begin; i < end; i++) {
+      const auto& factor = graph_[i];
+      if (factor && factor->sendable()) {
+        linear->replace(i, factor->linearize(values));
+      }
+    }
+  });
+
+  // Factors that are not thread-safe are linearized on this thread.
+  for (size_t i = 0; i < num_factors; i++) {
+    const auto& factor = graph_[i];
+    if (factor && !factor->sendable()) {
+      linear->replace(i, factor->linearize(values));
+    }
+  }
+  return linear;
 }
 
 /* ************************************************************************* */
@@ -171,7 +240,9 @@ bool MutableLMOptimizer::tryLambda(const GaussianFactorGraph& linear,
       // update values
       gttic(retract);
       // ============ This is where the solution is updated ====================
-      newValues = currentState->values.retract(delta);
+      newValues = retract_function_
+                      ? retract_function_(currentState->values, delta)
+                      : currentState->values.retract(delta);
       // =======================================================================
       gttoc(retract);
 
@@ -322,8 +393,32 @@ MutableLMOptimizer::MutableLMOptimizer(const NonlinearFactorGraph& graph,
                      Values(), 0., params.lambdaInitial, params.lambdaFactor))),
       params_(LevenbergMarquardtParams::EnsureHasOrdering(params, graph)) {}
 
+/* ************************************************************************* */
+VectorValues MutableLMOptimizer::solve(
+    const GaussianFactorGraph& gfg,
+    const NonlinearOptimizerParams& params) const {
+  if (linear_solver_) return linear_solver_(gfg);
+  if (!params.ordering || !(params.isMultifrontal() || params.isSequential()))
+    return NonlinearOptimizer::solve(gfg, params);
+
+  // The damped system only changes numerically between solves.
+  if (!damped_structure_ || !SameStructure(damped_keys_, gfg)) {
+    damped_structure_ = std::make_shared<VariableIndex>(gfg);
+    damped_keys_ = FactorKeys(gfg);
+  }
+  const Ordering& ordering = *params.ordering;
+  const auto eliminate = params.getEliminationFunction();
+  if (params.isMultifrontal()) {
+    return gfg.eliminateMultifrontal(ordering, eliminate, *damped_structure_)
+        ->optimize();
+  }
+  return gfg.eliminateSequential(ordering, eliminate, *damped_structure_)
+      ->optimize();
+}
+
 /* ************************************************************************* */
 void MutableLMOptimizer::setGraph(const NonlinearFactorGraph& graph) {
+  if (!SameStructure(graph_, graph)) damped_structure_.reset();
   graph_ = graph;
   params_ = LevenbergMarquardtParams::EnsureHasOrdering(params_, graph);
 }
@@ -331,12 +426,15 @@ void MutableLMOptimizer::setGraph(const NonlinearFactorGraph& graph) {
 /* ************************************************************************* */
 void MutableLMOptimizer::setGraph(const NonlinearFactorGraph& graph,
                                   const Ordering& ordering) {
+  damped_structure_.reset();
   graph_ = graph;
   params_ = LevenbergMarquardtParams::ReplaceOrdering(params_, ordering);
 }
 
 /* ************************************************************************* */
 void MutableLMOptimizer::setValues(const Values& values) {
+  // One damping factor per variable.
+  if (values.keys() != state_->values.keys()) damped_structure_.reset();
   state_ = std::unique_ptr<State>(new State((values), graph_.error(values),
                                             params_.lambdaInitial,
                                             params_.lambdaFactor));
@@ -344,6 +442,7 @@ void MutableLMOptimizer::setValues(const Values& values) {
 
 /* ************************************************************************* */
 void MutableLMOptimizer::setValues(Values&& values) {
+  if (values.keys() != state_->values.keys()) damped_structure_.reset();
   state_ = std::unique_ptr<State>(
       new State(std::move(values), graph_.error(values), params_.lambdaInitial,
                 params_.lambdaFactor));
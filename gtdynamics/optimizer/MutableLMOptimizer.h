@@ -22,18 +22,25 @@
 
 #pragma once
 
+#include <gtsam/inference/VariableIndex.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/nonlinear/LevenbergMarquardtParams.h>
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
 
 #include <chrono>
+#include <functional>
+#include <vector>
 
 class NonlinearOptimizerMoreOptimizationTest;
 
 namespace gtsam {
 
 /**
- * This class performs Levenberg-Marquardt nonlinear optimization
+ * This class performs Levenberg-Marquardt nonlinear optimization. The graph
+ * and values can be replaced between optimizations. As long as the structure
+ * of the graph, i.e., the keys of every factor, and the keys of the values do
+ * not change, the ordering and the variable index of the damped linear system
+ * are computed only once and reused by every elimination.
  */
 class GTSAM_EXPORT MutableLMOptimizer : public NonlinearOptimizer {
  protected:
@@ -48,6 +55,31 @@ class GTSAM_EXPORT MutableLMOptimizer : public NonlinearOptimizer {
  public:
   typedef std::shared_ptr<MutableLMOptimizer> shared_ptr;
 
+  /// Function that updates the values by a delta, Values::retract by default.
+  typedef std::function<Values(const Values&, const VectorValues&)>
+      RetractFunction;
+
+  /// Function that solves the damped linear system, e.g., TimeMajorSolve.
+  typedef std::function<VectorValues(const GaussianFactorGraph&)>
+      LinearSolverFunction;
+
+ protected:
+  RetractFunction retract_function_;  ///< empty for Values::retract
+  LinearSolverFunction linear_solver_;  ///< empty for the solver in params
+
+  /// Variable index of the damped system, cached across solves.
+  mutable std::shared_ptr<VariableIndex> damped_structure_;
+
+  /// Keys of every factor of the damped system the index was built for.
+  mutable std::vector<KeyVector> damped_keys_;
+
+  size_t num_threads_ = 1;  ///< threads to linearize with, 0 for all
+
+ public:
+
+  /** Access the graph to modify factors in place. The set of keys shall not
+   * change, as the ordering is not recomputed. The variable index of the
+   * damped system is rebuilt if the keys of any factor changed. */
   NonlinearFactorGraph& mutableGraph() { return graph_; }
 
   /// @name Constructors/Destructor
@@ -114,6 +146,21 @@ class GTSAM_EXPORT MutableLMOptimizer : public NonlinearOptimizer {
 
   void setValues(const Values& values);
 
+  /// Replace the retraction used to update the values.
+  void setRetractFunction(const RetractFunction& retract_function) {
+    retract_function_ = retract_function;
+  }
+
+  /// Replace the linear solver set in the parameters.
+  void setLinearSolver(const LinearSolverFunction& linear_solver) {
+    linear_solver_ = linear_solver;
+  }
+
+  /** Set the number of threads to linearize the graph with, 0 for all
+   * hardware threads. The linearize methods of sendable factors are then
+   * called concurrently. */
+  void setNumThreads(size_t num_threads) { num_threads_ = num_threads; }
+
   /// @name Advanced interface
   /// @{
 
@@ -128,7 +175,9 @@ class GTSAM_EXPORT MutableLMOptimizer : public NonlinearOptimizer {
 
   void writeLogFile(double currentError);
 
-  /** linearize, can be overwritten */
+  /** linearize, can be overwritten. With more than one thread, contiguous
+   * blocks of factors are linearized concurrently into their slots of the
+   * linear graph, which is identical to the one of the serial path. */
   virtual GaussianFactorGraph::shared_ptr linearize() const;
 
   /** Build a damped system for a specific lambda -- for testing only */
@@ -140,6 +189,12 @@ class GTSAM_EXPORT MutableLMOptimizer : public NonlinearOptimizer {
   bool tryLambda(const GaussianFactorGraph& linear,
                  const VectorValues& sqrtHessianDiagonal);
 
+  /** Solve the damped system, with the linear solver if one is set. Else,
+   * with an ordering and a direct solver, the elimination uses the cached
+   * variable index of the damped system. */
+  VectorValues solve(const GaussianFactorGraph& gfg,
+                     const NonlinearOptimizerParams& params) const override;
+
   /// @}
 
  protected:
@@ -12,8 +12,10 @@
  */
 
 #include <gtdynamics/optimizer/AugmentedLagrangianOptimizer.h>
+#include <gtdynamics/optimizer/MutableLMOptimizer.h>
 #include <gtdynamics/optimizer/Optimizer.h>
 #include <gtdynamics/optimizer/PenaltyMethodOptimizer.h>
+#include <gtdynamics/utils/Parallel.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 
 namespace gtdynamics {
@@ -23,6 +25,14 @@ using gtsam::Values;
 
 Values Optimizer::optimize(const NonlinearFactorGraph& graph,
                            const Values& initial_values) const {
+  if (NumThreads(p_.linearize_threads) > 1) {
+    // Same iterations as LevenbergMarquardtOptimizer, but linearize the
+    // factors concurrently.
+    gtsam::MutableLMOptimizer optimizer(graph, initial_values,
+                                        p_.lm_parameters);
+    optimizer.setNumThreads(p_.linearize_threads);
+    return optimizer.optimize();
+  }
   gtsam::LevenbergMarquardtOptimizer optimizer(graph, initial_values,
                                                p_.lm_parameters);
   const Values result = optimizer.optimize();
@@ -41,12 +51,14 @@ Values Optimizer::optimize(const gtsam::NonlinearFactorGraph& graph,
 
   } else if (p_.method == OptimizationParameters::Method::PENALTY) {
     PenaltyMethodParameters params = p_.lm_parameters;
+    params.linearize_threads = p_.linearize_threads;
     PenaltyMethodOptimizer optimizer(params);
     return optimizer.optimize(graph, constraints, initial_values);
 
   } else if (p_.method ==
              OptimizationParameters::Method::AUGMENTED_LAGRANGIAN) {
     AugmentedLagrangianParameters params = p_.lm_parameters;
+    params.linearize_threads = p_.linearize_threads;
     AugmentedLagrangianOptimizer optimizer(params);
     return optimizer.optimize(graph, constraints, initial_values);
 
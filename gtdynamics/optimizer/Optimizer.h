@@ -31,6 +31,7 @@ struct OptimizationParameters {
 
   Method method = Method::SOFT_CONSTRAINTS;       // optimization method
   gtsam::LevenbergMarquardtParams lm_parameters;  // LM parameters
+  size_t linearize_threads = 1;  // threads to linearize with, 0 for all
   OptimizationParameters() {
     lm_parameters.setlambdaInitial(1e7);
     lm_parameters.setAbsoluteErrorTol(1e-3);
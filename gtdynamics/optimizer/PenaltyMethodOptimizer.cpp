@@ -11,6 +11,7 @@
  * @author: Yetong Zhang
  */
 
+#include <gtdynamics/optimizer/MutableLMOptimizer.h>
 #include <gtdynamics/optimizer/PenaltyMethodOptimizer.h>
 
 namespace gtdynamics {
@@ -22,19 +23,25 @@ gtsam::Values PenaltyMethodOptimizer::optimize(
   gtsam::Values values = initial_values;
   double mu = p_.initial_mu;
 
+  // Construct merit function once, updating the penalty parameter of the
+  // constraint factors in place.
+  gtsam::NonlinearFactorGraph merit_graph = graph;
+  auto merit_factors = CreateMeritFactors(constraints);
+  for (const auto& factor : merit_factors) {
+    merit_graph.add(factor);
+  }
+  gtsam::MutableLMOptimizer optimizer(merit_graph, p_.lm_parameters);
+  optimizer.setNumThreads(p_.linearize_threads);
+
   // Solve the constrained optimization problem by solving a sequence of
   // unconstrained optimization problems.
   for (int i = 0; i < p_.num_iterations; i++) {
-    gtsam::NonlinearFactorGraph merit_graph = graph;
-
-    // Create factors corresponding to penalty terms of constraints.
-    for (auto& constraint : constraints) {
-      merit_graph.add(constraint->createFactor(mu));
+    for (auto& factor : merit_factors) {
+      factor->setPenalty(mu);
     }
 
     // Run optimization.
-    gtsam::LevenbergMarquardtOptimizer optimizer(merit_graph, values,
-                                                 p_.lm_parameters);
+    optimizer.setValues(values);
     auto result = optimizer.optimize();
 
     // Save results and update parameters.
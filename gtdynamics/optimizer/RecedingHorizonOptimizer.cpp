@@ -0,0 +1,91 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  RecedingHorizonOptimizer.cpp
+ * @brief Warm-started trajectory optimization over a sliding time window.
+ */
+
+#include <gtdynamics/optimizer/RecedingHorizonOptimizer.h>
+#include <gtdynamics/utils/DynamicsSymbol.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gtdynamics {
+
+using gtsam::Key;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+/* ************************************************************************* */
+const Values &RecedingHorizonOptimizer::solve(const NonlinearFactorGraph &graph,
+                                              const Values &initial_values) {
+  gtsam::LevenbergMarquardtParams params = p_.lm_parameters;
+  if (lambda_) {
+    params.setlambdaInitial(std::clamp(*lambda_, params.lambdaLowerBound,
+                                       params.lambdaUpperBound));
+  }
+  gtsam::LevenbergMarquardtOptimizer optimizer(graph, initial_values, params);
+  solution_ = optimizer.optimize();
+  lambda_ = optimizer.lambda();
+  iterations_ = optimizer.iterations();
+  return solution_;
+}
+
+/* ************************************************************************* */
+Values RecedingHorizonOptimizer::shiftedValues(
+    const NonlinearFactorGraph &graph, size_t shift,
+    const Values &fallback_values) const {
+  if (solution_.empty()) {
+    throw std::runtime_error(
+        "RecedingHorizonOptimizer: no previous solution to shift.");
+  }
+
+  // Final time step of the previous window.
+  uint64_t k_end = 0;
+  for (const Key &key : solution_.keys()) {
+    if (!static_keys_.count(key)) {
+      k_end = std::max(k_end, DynamicsSymbol(key).time());
+    }
+  }
+  if (shift > k_end) {
+    throw std::invalid_argument(
+        "RecedingHorizonOptimizer: cannot shift beyond the previous window.");
+  }
+
+  Values shifted =
+      ShiftValues(solution_, -static_cast<int>(shift), static_keys_);
+
+  // Hold the final state for the new steps at the end of the window.
+  for (const Key &key : solution_.keys()) {
+    if (static_keys_.count(key)) continue;
+    const DynamicsSymbol symbol(key);
+    if (symbol.time() != k_end) continue;
+    for (uint64_t k = k_end - shift + 1; k <= k_end; k++) {
+      shifted.insert(symbol.withTime(k), solution_.at(key));
+    }
+  }
+
+  Values initial_values;
+  for (const Key &key : graph.keys()) {
+    if (shifted.exists(key)) {
+      initial_values.insert(key, shifted.at(key));
+    } else if (fallback_values.exists(key)) {
+      initial_values.insert(key, fallback_values.at(key));
+    } else {
+      throw std::runtime_error(
+          "RecedingHorizonOptimizer: no initial value for key " +
+          _GTDKeyFormatter(key));
+    }
+  }
+  return initial_values;
+}
+
+}  // namespace gtdynamics
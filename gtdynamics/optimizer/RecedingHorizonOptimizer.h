@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  RecedingHorizonOptimizer.h
+ * @brief Warm-started trajectory optimization over a sliding time window.
+ */
+
+#pragma once
+
+#include <gtdynamics/optimizer/Optimizer.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <optional>
+
+namespace gtdynamics {
+
+/**
+ * RecedingHorizonOptimizer solves a sequence of trajectory optimization
+ * problems over a window of time steps 0..T that slides forward by a few
+ * steps every control cycle, e.g., a Trajectory::multiPhaseFactorGraph for
+ * the next T steps of a gait.
+ *
+ * Instead of starting every cycle from Initializer values, the previous
+ * solution is shifted back in time with ShiftValues: the oldest steps are
+ * dropped, and the state at the final time step is held for the new steps
+ * at the end of the window. Levenberg-Marquardt is then warm-started from the
+ * shifted values, and with the damping it ended the previous solve with.
+ */
+class RecedingHorizonOptimizer : public Optimizer {
+ protected:
+  gtsam::KeySet static_keys_;
+  gtsam::Values solution_;
+  std::optional<double> lambda_;
+  size_t iterations_ = 0;
+
+ public:
+  /**
+   * Constructor.
+   * @param parameters optimization parameters, of which the LM parameters are
+   * used for every solve
+   * @param static_keys keys that do not encode a time step, e.g., phase
+   * durations, and are carried over without shifting
+   */
+  explicit RecedingHorizonOptimizer(
+      const OptimizationParameters &parameters = OptimizationParameters(),
+      const gtsam::KeySet &static_keys = {})
+      : Optimizer(parameters), static_keys_(static_keys) {}
+
+  /**
+   * Solve the problem for the current window, and keep the solution for the
+   * next cycle. LM starts with the final damping of the previous solve, if
+   * any.
+   *
+   * @param graph factor graph of the current window
+   * @param initial_values initial values for all variables of the graph
+   * @return Values the solution
+   */
+  const gtsam::Values &solve(const gtsam::NonlinearFactorGraph &graph,
+                             const gtsam::Values &initial_values);
+
+  /**
+   * Initial values for the window shifted `shift` steps ahead: the previous
+   * solution moved back by `shift` time steps, with the final state held for
+   * the new steps at the end.
+   *
+   * Values are restricted to the variables of `graph`. Variables that are not
+   * in the shifted solution, e.g., contact wrenches of a phase that just
+   * started, are taken from `fallback_values`.
+   *
+   * @param graph factor graph of the shifted window
+   * @param shift number of time steps the window moves ahead
+   * @param fallback_values values for variables not in the shifted solution
+   * @return gtsam::Values
+   */
+  gtsam::Values shiftedValues(
+      const gtsam::NonlinearFactorGraph &graph, size_t shift,
+      const gtsam::Values &fallback_values = gtsam::Values()) const;
+
+  /**
+   * Move the window `shift` steps ahead and solve, warm-started with
+   * shiftedValues.
+   *
+   * @param graph factor graph of the shifted window
+   * @param shift number of time steps the window moves ahead
+   * @param fallback_values values for variables not in the shifted solution
+   * @return Values the solution
+   */
+  const gtsam::Values &shiftAndSolve(
+      const gtsam::NonlinearFactorGraph &graph, size_t shift = 1,
+      const gtsam::Values &fallback_values = gtsam::Values()) {
+    return solve(graph, shiftedValues(graph, shift, fallback_values));
+  }
+
+  /// Solution of the last solve.
+  const gtsam::Values &solution() const { return solution_; }
+
+  /// LM damping at the end of the last solve, if any.
+  std::optional<double> lambda() const { return lambda_; }
+
+  /// Number of LM iterations of the last solve.
+  size_t iterations() const { return iterations_; }
+};
+
+}  // namespace gtdynamics
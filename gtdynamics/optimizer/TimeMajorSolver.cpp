@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  TimeMajorSolver.cpp
+ * @brief Linear solver for trajectory graphs, eliminating the variables time
+ * step by time step.
+ */
+
+#include <gtdynamics/optimizer/TimeMajorSolver.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <utility>
+
+using gtsam::GaussianFactorGraph;
+using gtsam::Key;
+using gtsam::Ordering;
+
+namespace gtdynamics {
+
+namespace {
+/// Constrained COLAMD, with the keys grouped by their elimination step.
+template <class GRAPH>
+Ordering TimeMajor(const GRAPH &graph) {
+  const gtsam::KeySet keys = graph.keys();
+  std::set<uint64_t> times;
+  for (Key key : keys) times.insert(KeyStep(key));
+
+  // Groups have to be consecutive integers.
+  std::map<uint64_t, int> group_of_time;
+  for (uint64_t t : times) {
+    group_of_time.emplace(t, static_cast<int>(group_of_time.size()));
+  }
+  gtsam::FastMap<Key, int> groups;
+  for (Key key : keys) groups[key] = group_of_time.at(KeyStep(key));
+  return Ordering::ColamdConstrained(graph, groups);
+}
+}  // namespace
+
+Ordering TimeMajorOrdering(const gtsam::NonlinearFactorGraph &graph) {
+  return TimeMajor(graph);
+}
+
+Ordering TimeMajorOrdering(const GaussianFactorGraph &graph) {
+  return TimeMajor(graph);
+}
+
+gtsam::VectorValues TimeMajorSolve(
+    const GaussianFactorGraph &graph,
+    const GaussianFactorGraph::Eliminate &function) {
+  // Factors by the earliest time step of their keys.
+  std::map<uint64_t, GaussianFactorGraph> steps;
+  auto add = [&steps](const gtsam::GaussianFactor::shared_ptr &factor) {
+    if (!factor || factor->empty()) return;
+    uint64_t t = kLastStep;
+    for (Key key : factor->keys()) t = std::min(t, KeyStep(key));
+    steps[t].push_back(factor);
+  };
+  for (auto &&factor : graph) add(factor);
+
+  // Forward pass: eliminate the earliest time step, and carry the remaining
+  // factors, which only involve later time steps, forward.
+  gtsam::GaussianBayesNet bayes_net;
+  while (!steps.empty()) {
+    const uint64_t t = steps.begin()->first;
+    const GaussianFactorGraph step_graph = std::move(steps.begin()->second);
+    steps.erase(steps.begin());
+
+    // Order the variables of time step t first, keeping the separator last.
+    gtsam::KeyVector separator;
+    size_t num_frontals = 0;
+    for (Key key : step_graph.keys()) {
+      if (KeyStep(key) == t) {
+        num_frontals++;
+      } else {
+        separator.push_back(key);
+      }
+    }
+    Ordering ordering = Ordering::ColamdConstrainedLast(step_graph, separator);
+    ordering.resize(num_frontals);
+
+    const auto [step_bayes_net, remaining] =
+        step_graph.eliminatePartialSequential(ordering, function);
+    bayes_net.push_back(step_bayes_net->begin(), step_bayes_net->end());
+    for (auto &&factor : *remaining) add(factor);
+  }
+
+  // Backward pass: back-substitution, from the last time step to the first.
+  return bayes_net.optimize();
+}
+
+}  // namespace gtdynamics
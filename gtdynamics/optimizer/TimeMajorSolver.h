@@ -0,0 +1,84 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  TimeMajorSolver.h
+ * @brief Linear solver for trajectory graphs, eliminating the variables time
+ * step by time step.
+ */
+
+#pragma once
+
+#include <gtdynamics/utils/DynamicsSymbol.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <cstdint>
+#include <limits>
+
+namespace gtdynamics {
+
+/// Time step of a key, as encoded in its DynamicsSymbol.
+inline uint64_t KeyTime(gtsam::Key key) { return DynamicsSymbol(key).time(); }
+
+/// Whether the key is a phase duration, whose symbol encodes the phase.
+inline bool IsPhaseKey(gtsam::Key key) {
+  return key == PhaseKey(static_cast<int>(KeyTime(key)));
+}
+
+/// Elimination step of phase keys, after all time steps.
+constexpr uint64_t kLastStep = std::numeric_limits<uint64_t>::max();
+
+/**
+ * Elimination step of a key: its time step, or kLastStep for phase keys,
+ * which couple all time steps of a phase and are eliminated last.
+ */
+inline uint64_t KeyStep(gtsam::Key key) {
+  return IsPhaseKey(key) ? kLastStep : KeyTime(key);
+}
+
+/**
+ * Ordering that eliminates all variables of a time step before the variables
+ * of the next time step, and orders the variables within a time step with
+ * constrained COLAMD. Phase keys are eliminated last, see KeyStep. For a
+ * trajectory graph, in which factors only couple neighboring time steps and
+ * the phase durations, elimination in this order is a block-banded
+ * recursion over the time steps.
+ */
+gtsam::Ordering TimeMajorOrdering(const gtsam::NonlinearFactorGraph &graph);
+
+/// Time-major ordering of a linear graph, e.g., a linearized trajectory graph.
+gtsam::Ordering TimeMajorOrdering(const gtsam::GaussianFactorGraph &graph);
+
+/**
+ * Solve the least-squares problem of a linear trajectory graph by a forward
+ * Riccati-style recursion over the time steps, followed by back-substitution.
+ *
+ * At time step t, the factors on the variables of t, including the factor
+ * carried over from t-1, are eliminated in a sparse partial elimination. The
+ * remaining factor on the variables of later time steps, the cost-to-go, is
+ * carried over to the next time step. The working set therefore never spans
+ * more than the time step, its separator and the phase keys, whatever the
+ * horizon.
+ *
+ * The time step of every key is KeyStep(key): phase keys are carried along
+ * as part of the separator and eliminated after the last time step. The
+ * solution is exact for any keys.
+ *
+ * @param graph     the linear graph, e.g., a damped Gauss-Newton system
+ * @param function  the dense elimination function used within a time step
+ */
+gtsam::VectorValues TimeMajorSolve(
+    const gtsam::GaussianFactorGraph &graph,
+    const gtsam::GaussianFactorGraph::Eliminate &function =
+        gtsam::EliminatePreferCholesky);
+
+}  // namespace gtdynamics
@@ -0,0 +1,34 @@
+/**
+ * @file  PandaAnalyticIK.cpp
+ * @brief Analytic inverse kinematics of the Panda arm, for AnalyticIKRegistry.
+ */
+
+#include <gtdynamics/pandarobot/ikfast/PandaAnalyticIK.h>
+#include <gtdynamics/pandarobot/ikfast/PandaIKFast.h>
+
+namespace gtdynamics {
+
+using gtsam::Pose3;
+
+// Pose of the link frame in the CoM frame of a link.
+static Pose3 ComTLink(const LinkSharedPtr &link) {
+  return link->bMcom().between(link->bMlink());
+}
+
+PandaAnalyticIK::PandaAnalyticIK(const Robot &robot, double theta7)
+    : AnalyticIK(robot, "link0", "link7"),
+      base_comTlink_(ComTLink(robot.link("link0"))),
+      tip_comTlink_(ComTLink(robot.link("link7"))),
+      theta7_(theta7) {}
+
+std::vector<gtsam::Vector> PandaAnalyticIK::inversePose(
+    const Pose3 &bTt) const {
+  const Pose3 bTe = base_comTlink_.inverse() * bTt * tip_comTlink_;
+  std::vector<gtsam::Vector> solutions;
+  for (auto &&solution : PandaIKFast::inverse(bTe, theta7_)) {
+    solutions.push_back(solution);
+  }
+  return solutions;
+}
+
+}  // namespace gtdynamics
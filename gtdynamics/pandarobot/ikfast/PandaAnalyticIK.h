@@ -0,0 +1,36 @@
+/**
+ * @file  PandaAnalyticIK.h
+ * @brief Analytic inverse kinematics of the Panda arm, for AnalyticIKRegistry.
+ */
+
+#pragma once
+
+#include <gtdynamics/kinematics/AnalyticIK.h>
+
+#include <vector>
+
+namespace gtdynamics {
+
+/**
+ * PandaIKFast as an analytic solver for the chain from link0 to link7 of the
+ * Panda robot in models/urdfs/panda. IKFast works with the link frames, which
+ * are converted to and from the link CoM frames used by AnalyticIK.
+ */
+class PandaAnalyticIK : public AnalyticIK {
+  gtsam::Pose3 base_comTlink_, tip_comTlink_;
+  double theta7_;
+
+ public:
+  /**
+   * Constructor.
+   * @param robot the Panda robot
+   * @param theta7 value of the redundant 7th joint angle, which parameterizes
+   * the 1D family of solutions
+   */
+  explicit PandaAnalyticIK(const Robot &robot, double theta7 = 0.0);
+
+  std::vector<gtsam::Vector> inversePose(
+      const gtsam::Pose3 &bTt) const override;
+};
+
+}  // namespace gtdynamics
@@ -18,11 +18,13 @@
 
 //----------------------------------------------------------------------------//
 
+#include <gtdynamics/utils/Parallel.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/geometry/Pose3.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -89,4 +91,36 @@ std::vector<Vector7> PandaIKFast::inverse(const Pose3& bTe, double theta7) {
   return joint_values;
 }
 
+size_t PandaIKFast::inverseBatch(const Pose3* bTe, const double* theta7,
+                                 size_t num_poses, double* solutions,
+                                 uint8_t* valid, size_t num_threads) {
+  std::vector<size_t> num_solutions(num_poses, 0);
+  ParallelFor(num_poses, num_threads, [&](size_t i) {
+    double* pose_solutions = solutions + i * kMaxSolutions * kNumJoints;
+    uint8_t* pose_valid = valid + i * kMaxSolutions;
+    std::fill(pose_valid, pose_valid + kMaxSolutions, 0);
+
+    const Matrix3 bRe = bTe[i].rotation().matrix().transpose();
+    ikfast::IkSolutionList<panda_internal::IkReal> ik_solutions;
+    if (!panda_internal::ComputeIk(bTe[i].translation().data(), bRe.data(),
+                                   &theta7[i], ik_solutions)) {
+      return;
+    }
+
+    // Skip singular solutions, as in inverse.
+    size_t s = 0;
+    for (size_t k = 0; k < ik_solutions.GetNumSolutions(); ++k) {
+      const auto& sol = ik_solutions.GetSolution(k);
+      if (sol.GetFree().size() != 0 || s == kMaxSolutions) continue;
+      sol.GetSolution(pose_solutions + s * kNumJoints, NULL);
+      pose_valid[s++] = 1;
+    }
+    num_solutions[i] = s;
+  });
+
+  size_t total = 0;
+  for (size_t n : num_solutions) total += n;
+  return total;
+}
+
 }  // namespace gtdynamics
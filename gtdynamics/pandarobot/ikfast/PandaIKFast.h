@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace gtdynamics {
@@ -26,6 +27,9 @@ class PandaIKFast {
   // The robot's number of joints, for the panda it's 7
   static constexpr size_t kNumJoints = 7;
 
+  // Maximum number of solutions for one pose and value of the 7th joint
+  static constexpr size_t kMaxSolutions = 8;
+
   /**
    * @brief Forward Kinematics on Panda robot using IKFast.
    *
@@ -46,6 +50,29 @@ class PandaIKFast {
    */
   static std::vector<gtsam::Vector7> inverse(const gtsam::Pose3& bRe,
                                              double theta7);
+
+  /**
+   * @brief Inverse Kinematics on Panda robot using IKFast, for many target
+   * poses at once. Poses are distributed over threads; the generated IKFast
+   * code is too branchy to vectorize across poses.
+   *
+   * Solutions are written to a flat, preallocated buffer with kMaxSolutions
+   * slots of kNumJoints joint angles per pose, i.e., joint j of solution s for
+   * pose i is at solutions[(i * kMaxSolutions + s) * kNumJoints + j]. Slots
+   * are filled in order, and valid[i * kMaxSolutions + s] is set to 1 for the
+   * filled slots and 0 for the others.
+   *
+   * @param bTe -- array of num_poses desired end-effector poses
+   * @param theta7 -- array of num_poses values for the 7th joint angle
+   * @param num_poses -- number of target poses
+   * @param solutions -- buffer of num_poses * kMaxSolutions * kNumJoints
+   * @param valid -- validity mask of num_poses * kMaxSolutions
+   * @param num_threads -- number of threads, 0 for all hardware threads
+   * @return size_t -- total number of solutions
+   */
+  static size_t inverseBatch(const gtsam::Pose3* bTe, const double* theta7,
+                             size_t num_poses, double* solutions,
+                             uint8_t* valid, size_t num_threads = 1);
 };
 
 }  // namespace gtdynamics
@@ -0,0 +1,56 @@
+/**
+ * @file  testPandaAnalyticIK.cpp
+ * @brief Test the Panda IKFast solver as an analytic IK solver.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/pandarobot/ikfast/PandaAnalyticIK.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::Pose3;
+using gtsam::Values;
+
+// Pose of link7 in the link0 CoM frame, with link0 at rest.
+static Pose3 TipPose(const Robot &robot, const gtsam::Vector &q,
+                     const std::vector<std::string> &joint_names) {
+  Values known;
+  const auto base = robot.link("link0");
+  InsertPose(&known, base->id(), 0, base->bMcom());
+  for (size_t i = 0; i < joint_names.size(); i++) {
+    InsertJointAngle(&known, robot.joint(joint_names[i])->id(), 0, q(i));
+  }
+  const Values fk = robot.forwardKinematics(known, 0, std::string("link0"));
+  return base->bMcom().between(Pose(fk, robot.link("link7")->id()));
+}
+
+TEST(PandaAnalyticIK, InversePose) {
+  const Robot robot =
+      CreateRobotFromFile(kUrdfPath + std::string("panda/panda.urdf"));
+  const double theta7 = 0.3;
+  PandaAnalyticIK solver(robot, theta7);
+  EXPECT_LONGS_EQUAL(7, solver.jointNames().size());
+  AnalyticIKRegistry registry;
+  registry.add(std::make_shared<PandaAnalyticIK>(solver));
+  EXPECT(registry.find("link7"));
+
+  gtsam::Vector q(7);
+  q << 0.2, -0.4, 0.1, -1.8, 0.3, 1.5, theta7;
+  const Pose3 bTt = TipPose(robot, q, solver.jointNames());
+
+  const auto solutions = solver.inversePose(bTt);
+  CHECK(!solutions.empty());
+  for (auto &&solution : solutions) {
+    EXPECT(assert_equal(bTt, TipPose(robot, solution, solver.jointNames()),
+                        1e-5));
+  }
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
@@ -11,6 +11,7 @@
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/geometry/Pose3.h>
 
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -90,6 +91,45 @@ TEST(PandaIKFast, Inverse) {
   }
 }
 
+TEST(PandaIKFast, InverseBatch) {
+  constexpr size_t kMax = PandaIKFast::kMaxSolutions;
+  constexpr size_t kJoints = PandaIKFast::kNumJoints;
+
+  // Reachable poses from forward kinematics, and one far out of reach.
+  std::vector<Pose3> poses;
+  std::vector<double> theta7;
+  for (size_t i = 0; i < 20; ++i) {
+    Vector7 q;
+    for (size_t j = 0; j < kJoints; ++j) q(j) = 0.1 * std::sin(i + 2.0 * j);
+    q(3) -= 1.5;
+    poses.push_back(PandaIKFast::forward(q));
+    theta7.push_back(q(6));
+  }
+  poses.push_back(Pose3(Rot3(), Point3(10, 0, 0)));
+  theta7.push_back(0.0);
+  const size_t n = poses.size();
+
+  std::vector<double> solutions(n * kMax * kJoints);
+  std::vector<uint8_t> valid(n * kMax, 2);
+  const size_t total = PandaIKFast::inverseBatch(
+      poses.data(), theta7.data(), n, solutions.data(), valid.data(), 4);
+
+  // Same solutions as the scalar call, in the same order.
+  size_t expected_total = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const auto expected = PandaIKFast::inverse(poses[i], theta7[i]);
+    expected_total += expected.size();
+    for (size_t s = 0; s < kMax; ++s) {
+      EXPECT_LONGS_EQUAL(s < expected.size(), valid[i * kMax + s]);
+      if (s >= expected.size()) continue;
+      const Vector7 actual(&solutions[(i * kMax + s) * kJoints]);
+      EXPECT(assert_equal(expected[s], actual, 1e-12));
+    }
+  }
+  EXPECT_LONGS_EQUAL(expected_total, total);
+  EXPECT_LONGS_EQUAL(0, valid[(n - 1) * kMax]);
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
@@ -0,0 +1,178 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  KinematicTree.cpp
+ * @brief Precompiled link-joint spanning tree for fast forward kinematics.
+ */
+
+#include <gtdynamics/universal_robot/KinematicTree.h>
+#include <gtdynamics/utils/values.h>
+
+#include <limits>
+#include <stdexcept>
+
+using gtsam::Pose3;
+using gtsam::Values;
+using gtsam::Vector6;
+
+namespace gtdynamics {
+
+/* ************************************************************************* */
+KinematicTree::KinematicTree(const LinkSharedPtr &root) {
+  constexpr size_t kMaxIds = std::numeric_limits<uint8_t>::max() + 1;
+  std::vector<int> link_index(kMaxIds, -1);
+  std::vector<bool> joint_visited(kMaxIds, false);
+
+  links_.push_back(root);
+  joints_.push_back(nullptr);
+  parents_.push_back(-1);
+  M_.push_back(Pose3());
+  S_.push_back(Vector6::Zero());
+  link_index[root->id()] = 0;
+
+  for (size_t head = 0; head < links_.size(); ++head) {
+    const LinkSharedPtr link = links_[head];
+    for (auto &&joint : link->joints()) {
+      if (joint_visited[joint->id()]) continue;
+      joint_visited[joint->id()] = true;
+      const auto other = joint->otherLink(link);
+      if (link_index[other->id()] >= 0) {
+        loop_joints_.push_back(
+            {joint, static_cast<int>(head), link_index[other->id()]});
+        continue;
+      }
+      link_index[other->id()] = static_cast<int>(links_.size());
+      links_.push_back(other);
+      joints_.push_back(joint);
+      parents_.push_back(static_cast<int>(head));
+      // Both directions reduce to T_pk(q) = M_pk * exp(S_k * q), where S_k is
+      // the screw axis in the frame of the link being reached.
+      M_.push_back(joint->child() == other ? joint->pMc()
+                                           : joint->pMc().inverse());
+      S_.push_back(joint->screwAxis(other));
+    }
+  }
+}
+
+/* ************************************************************************* */
+void KinematicTree::forward(const Pose3 &wTroot, const Vector6 &V_root,
+                            const std::vector<double> &q,
+                            const std::vector<double> &q_dot,
+                            std::vector<Pose3> *poses,
+                            std::vector<Vector6> *twists) const {
+  const size_t n = size();
+  poses->resize(n);
+  twists->resize(n);
+  (*poses)[0] = wTroot;
+  (*twists)[0] = V_root;
+  for (size_t k = 1; k < n; ++k) {
+    const int p = parents_[k];
+    const Pose3 pTk = M_[k] * Pose3::Expmap(S_[k] * q[k]);
+    (*poses)[k] = (*poses)[p] * pTk;
+    (*twists)[k] = pTk.inverse().Adjoint((*twists)[p]) + S_[k] * q_dot[k];
+  }
+}
+
+/* ************************************************************************* */
+// Joint angle or velocity in values, zero if it does not exist.
+static double AtOrZero(const Values &values, gtsam::Key key) {
+  return values.exists(key) ? values.atDouble(key) : 0.0;
+}
+
+// Check a computed pose/twist against the one already in values.
+static void CheckConsistent(const Pose3 &pose, const Vector6 &twist,
+                            const Pose3 &known_pose,
+                            const Vector6 &known_twist) {
+  if (!(pose.equals(known_pose, 1e-4) && (twist - known_twist).norm() < 1e-4)) {
+    throw std::runtime_error(
+        "Inconsistent joint angles detected in forward kinematics");
+  }
+}
+
+/* ************************************************************************* */
+void KinematicTree::forward(const Values &values, size_t t,
+                            std::vector<Pose3> *poses,
+                            std::vector<Vector6> *twists) const {
+  const size_t n = size();
+  poses->resize(n);
+  twists->resize(n);
+
+  // Root pose and twist, with defaults.
+  const int root_id = root()->id();
+  const auto root_pose_key = PoseKey(root_id, t);
+  const auto root_twist_key = TwistKey(root_id, t);
+  (*poses)[0] = values.exists(root_pose_key) ? values.at<Pose3>(root_pose_key)
+                                             : Pose3();
+  (*twists)[0] = values.exists(root_twist_key)
+                     ? values.at<Vector6>(root_twist_key)
+                     : Vector6::Zero().eval();
+
+  // Single pass in traversal order, continuing from known poses and twists.
+  for (size_t k = 1; k < n; ++k) {
+    const int j = joints_[k]->id(), i = links_[k]->id();
+    const double q = AtOrZero(values, JointAngleKey(j, t));
+    const double q_dot = AtOrZero(values, JointVelKey(j, t));
+
+    const int p = parents_[k];
+    const Pose3 pTk = M_[k] * Pose3::Expmap(S_[k] * q);
+    (*poses)[k] = (*poses)[p] * pTk;
+    (*twists)[k] = pTk.inverse().Adjoint((*twists)[p]) + S_[k] * q_dot;
+
+    const auto pose_key = PoseKey(i, t);
+    if (values.exists(pose_key)) {
+      const Pose3 known_pose = values.at<Pose3>(pose_key);
+      const Vector6 known_twist = Twist(values, i, t);
+      CheckConsistent((*poses)[k], (*twists)[k], known_pose, known_twist);
+      (*poses)[k] = known_pose;
+      (*twists)[k] = known_twist;
+    }
+  }
+
+  // Joints closing loops have to agree with the tree.
+  for (auto &&loop : loop_joints_) {
+    const auto &joint = loop.joint;
+    const double q = AtOrZero(values, JointAngleKey(joint->id(), t));
+    const double q_dot = AtOrZero(values, JointVelKey(joint->id(), t));
+    const auto pose_twist = joint->otherPoseTwist(
+        links_[loop.from], (*poses)[loop.from], (*twists)[loop.from], q, q_dot);
+    CheckConsistent(pose_twist.first, pose_twist.second, (*poses)[loop.to],
+                    (*twists)[loop.to]);
+  }
+}
+
+/* ************************************************************************* */
+void KinematicTree::insert(size_t t, const std::vector<Pose3> &poses,
+                           const std::vector<Vector6> &twists,
+                           Values *values) const {
+  auto insert_zero = [values](gtsam::Key key) {
+    if (!values->exists(key)) values->insertDouble(key, 0.0);
+  };
+  for (size_t k = 0; k < size(); ++k) {
+    if (joints_[k]) {
+      insert_zero(JointAngleKey(joints_[k]->id(), t));
+      insert_zero(JointVelKey(joints_[k]->id(), t));
+    }
+    const int i = links_[k]->id();
+    if (!values->exists(PoseKey(i, t))) InsertPose(values, i, t, poses[k]);
+    if (!values->exists(TwistKey(i, t))) InsertTwist(values, i, t, twists[k]);
+  }
+  for (auto &&loop : loop_joints_) {
+    insert_zero(JointAngleKey(loop.joint->id(), t));
+    insert_zero(JointVelKey(loop.joint->id(), t));
+  }
+}
+
+/* ************************************************************************* */
+void KinematicTree::forwardKinematics(size_t t, Values *values) const {
+  std::vector<Pose3> poses;
+  std::vector<Vector6> twists;
+  forward(*values, t, &poses, &twists);
+  insert(t, poses, twists, values);
+}
+
+}  // namespace gtdynamics
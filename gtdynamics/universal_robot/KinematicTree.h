@@ -0,0 +1,141 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  KinematicTree.h
+ * @brief Precompiled link-joint spanning tree for fast forward kinematics.
+ */
+
+#pragma once
+
+#include <gtdynamics/universal_robot/Joint.h>
+#include <gtdynamics/universal_robot/Link.h>
+#include <gtdynamics/universal_robot/RobotTypes.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <vector>
+
+namespace gtdynamics {
+
+/**
+ * KinematicTree is a breadth-first spanning tree of the links reachable from
+ * a root link, compiled once into flat arrays indexed by traversal position.
+ * Every link comes after its parent in the traversal, and stores the rest pose
+ * relative to its parent and the joint screw axis in its own CoM frame, such
+ * that forward kinematics is a single loop over contiguous arrays:
+ *
+ *   T_pk(q) = M_pk * exp(S_k * q),
+ *   T_wk = T_wp * T_pk(q),
+ *   V_k = Ad(T_pk(q)^{-1}) * V_p + S_k * q_dot.
+ *
+ * Joints that close a loop are not part of the tree, and are only used to
+ * check the consistency of the result.
+ */
+class KinematicTree {
+ public:
+  /// A joint closing a kinematic loop between two links of the tree.
+  struct LoopJoint {
+    JointSharedPtr joint;
+    int from;  ///< traversal index of the link the joint was reached from
+    int to;    ///< traversal index of the other link
+  };
+
+ private:
+  std::vector<LinkSharedPtr> links_;    // links in traversal order
+  std::vector<JointSharedPtr> joints_;  // joint to the parent, null for root
+  std::vector<int> parents_;            // parent index, -1 for the root
+  std::vector<gtsam::Pose3> M_;         // rest pose in the parent CoM frame
+  std::vector<gtsam::Vector6> S_;       // screw axis in the link CoM frame
+  std::vector<LoopJoint> loop_joints_;
+
+ public:
+  /// Compile the spanning tree of all links reachable from `root`.
+  explicit KinematicTree(const LinkSharedPtr &root);
+
+  /// Number of links in the tree.
+  size_t size() const { return links_.size(); }
+
+  /// Root link, at traversal index 0.
+  const LinkSharedPtr &root() const { return links_.front(); }
+
+  /// Links in traversal order.
+  const std::vector<LinkSharedPtr> &links() const { return links_; }
+
+  /// Joint connecting each link to its parent, nullptr for the root.
+  const std::vector<JointSharedPtr> &joints() const { return joints_; }
+
+  /// Traversal index of the parent of each link, -1 for the root.
+  const std::vector<int> &parents() const { return parents_; }
+
+  /// Joints that are not part of the tree because they close a loop.
+  const std::vector<LoopJoint> &loopJoints() const { return loop_joints_; }
+
+  /**
+   * Compute poses and twists of all links in the tree.
+   *
+   * Joint angles and velocities are indexed by traversal position, i.e., the
+   * values of the joint connecting each link to its parent; the root entries
+   * are ignored. The output buffers are resized to size(), and only
+   * reallocated when they are too small.
+   *
+   * @param[in] wTroot root link CoM pose
+   * @param[in] V_root root link twist
+   * @param[in] q joint angles
+   * @param[in] q_dot joint velocities
+   * @param[out] poses CoM poses in traversal order
+   * @param[out] twists twists in traversal order
+   */
+  void forward(const gtsam::Pose3 &wTroot, const gtsam::Vector6 &V_root,
+               const std::vector<double> &q, const std::vector<double> &q_dot,
+               std::vector<gtsam::Pose3> *poses,
+               std::vector<gtsam::Vector6> *twists) const;
+
+  /**
+   * Compute poses and twists of all links at time t from Values, without
+   * modifying them.
+   *
+   * Missing joint angles and velocities are taken to be zero, and a missing
+   * root pose and twist default to identity and zero. Link poses and twists
+   * that are already present are checked for consistency, and the traversal
+   * continues from them. Throws std::runtime_error if they, or any loop
+   * joint, are inconsistent.
+   *
+   * @param[in] values Values with joint angles, joint velocities, and
+   * (optionally) link poses and twists
+   * @param[in] t integer time index
+   * @param[out] poses CoM poses in traversal order
+   * @param[out] twists twists in traversal order
+   */
+  void forward(const gtsam::Values &values, size_t t,
+               std::vector<gtsam::Pose3> *poses,
+               std::vector<gtsam::Vector6> *twists) const;
+
+  /**
+   * Insert the result of `forward` at time t into values, together with the
+   * zero joint angles and velocities that were assumed. Existing entries are
+   * left untouched.
+   */
+  void insert(size_t t, const std::vector<gtsam::Pose3> &poses,
+              const std::vector<gtsam::Vector6> &twists,
+              gtsam::Values *values) const;
+
+  /**
+   * Values adapter for forward kinematics at time t, in place.
+   *
+   * Calls `forward` and then `insert`, so missing joint angles and
+   * velocities are inserted as zero, and existing link poses and twists are
+   * checked instead of being overwritten.
+   *
+   * @param[in] t integer time index
+   * @param[in,out] values Values with joint angles, joint velocities, and
+   * (optionally) link poses and twists
+   */
+  void forwardKinematics(size_t t, gtsam::Values *values) const;
+};
+
+}  // namespace gtdynamics
@@ -14,12 +14,12 @@
 #include <gtdynamics/universal_robot/Joint.h>
 #include <gtdynamics/universal_robot/Robot.h>
 #include <gtdynamics/universal_robot/RobotTypes.h>
+#include <gtdynamics/utils/Parallel.h>
 #include <gtdynamics/utils/utils.h>
 #include <gtdynamics/utils/values.h>
 
 #include <algorithm>
 #include <memory>
-#include <queue>
 #include <sstream>
 #include <stdexcept>
 
@@ -67,6 +67,10 @@ void Robot::removeJoint(const JointSharedPtr &joint) {
   }
   // Remove the joint from name_to_joint_
   name_to_joint_.erase(joint->name());
+
+  // The topology changed, so all compiled kinematic trees are stale.
+  std::lock_guard<std::mutex> lock(tree_cache_->mutex);
+  tree_cache_->trees.clear();
 }
 
 LinkSharedPtr Robot::link(const std::string &name) const {
@@ -174,9 +178,9 @@ LinkSharedPtr Robot::findRootLink(
 }
 
 // Insert fixed link poses into values
-static void InsertFixedLinks(const std::vector<LinkSharedPtr> &links, size_t t,
+static void InsertFixedLinks(const LinkMap &links, size_t t,
                              gtsam::Values *values) {
-  for (auto &&link : links) {
+  for (auto &&[name, link] : links) {
     if (link->isFixed()) {
       InsertPose(values, link->id(), t, link->getFixedPose());
       InsertTwist(values, link->id(), t, Vector6::Zero());
@@ -184,40 +188,14 @@ static void InsertFixedLinks(const std::vector<LinkSharedPtr> &links, size_t t,
   }
 }
 
-// Add zero default values for joint angles and joint velocities.
-// if they do not yet exist
-static void InsertZeroDefaults(size_t j, size_t t, gtsam::Values *values) {
-  for (const auto key : {JointAngleKey(j, t), JointVelKey(j, t)}) {
-    if (!values->exists(key)) {
-      values->insertDouble(key, 0.0);
-    }
+std::shared_ptr<const KinematicTree> Robot::kinematicTree(
+    const LinkSharedPtr &root) const {
+  std::lock_guard<std::mutex> lock(tree_cache_->mutex);
+  auto &tree = tree_cache_->trees[root->id()];
+  if (!tree || tree->root() != root) {
+    tree = std::make_shared<const KinematicTree>(root);
   }
-}
-
-// Insert a pose/twist into values, but if they already are present, just check
-// if they are consistent. Throw exception otherwise.
-// Returns true if values were inserted.
-static bool InsertWithCheck(size_t i, size_t t,
-                            const std::pair<Pose3, Vector6> &poseTwist,
-                            gtsam::Values *values) {
-  Pose3 pose;
-  Vector6 twist;
-  std::tie(pose, twist) = poseTwist;
-  auto pose_key = PoseKey(i, t);
-  auto twist_key = TwistKey(i, t);
-  const bool exists = values->exists(pose_key);
-  if (!exists) {
-    values->insert(pose_key, pose);
-    values->insert<Vector6>(twist_key, twist);
-  } else {
-    // If already insert, check for consistency.
-    if (!(pose.equals(values->at<Pose3>(pose_key), 1e-4) &&
-          (twist - values->at<Vector6>(twist_key)).norm() < 1e-4)) {
-      throw std::runtime_error(
-          "Inconsistent joint angles detected in forward kinematics");
-    }
-  }
-  return !exists;
+  return tree;
 }
 
 gtsam::Values Robot::forwardKinematics(
@@ -227,40 +205,34 @@ gtsam::Values Robot::forwardKinematics(
 
   // Set root link.
   const auto root_link = findRootLink(values, prior_link_name);
-  InsertFixedLinks(links(), t, &values);
+  InsertFixedLinks(name_to_link_, t, &values);
 
-  if (!values.exists(PoseKey(root_link->id(), t))) {
-    InsertPose(&values, root_link->id(), t, gtsam::Pose3());
-  }
-  if (!values.exists(TwistKey(root_link->id(), t))) {
-    InsertTwist(&values, root_link->id(), t, gtsam::Vector6::Zero());
+  kinematicTree(root_link)->forwardKinematics(t, &values);
+  return values;
+}
+
+gtsam::Values Robot::forwardKinematics(
+    const gtsam::Values &known_values, const Interval &interval,
+    const std::optional<std::string> &prior_link_name,
+    size_t num_threads) const {
+  gtsam::Values values = known_values;
+
+  const auto root_link = findRootLink(values, prior_link_name);
+  const auto tree = kinematicTree(root_link);
+  const size_t num_steps = interval.k_end - interval.k_start + 1;
+  for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+    InsertFixedLinks(name_to_link_, k, &values);
   }
 
-  // BFS to update all poses downstream in the graph.
-  std::queue<LinkSharedPtr> q;
-  q.push(root_link);
-  int loop_count = 0;
-  while (!q.empty()) {
-    // Pop link from the queue and retrieve the pose and twist.
-    const auto link1 = q.front();
-    const Pose3 T_w1 = Pose(values, link1->id(), t);
-    const Vector6 V_1 = Twist(values, link1->id(), t);
-    q.pop();
-
-    // Loop through all joints to find the pose and twist of child links.
-    for (auto &&joint : link1->joints()) {
-      InsertZeroDefaults(joint->id(), t, &values);
-      const auto poseTwist = joint->otherPoseTwist(
-          link1, T_w1, V_1, JointAngle(values, joint->id(), t),
-          JointVel(values, joint->id(), t));
-      const auto link2 = joint->otherLink(link1);
-      if (InsertWithCheck(link2->id(), t, poseTwist, &values)) {
-        q.push(link2);
-      }
-    }
-    if (loop_count++ > 100000) {
-      throw std::runtime_error("infinite loop in bfs");
-    }
+  // Time steps only read the shared values, so they can run concurrently.
+  std::vector<std::vector<Pose3>> poses(num_steps);
+  std::vector<std::vector<Vector6>> twists(num_steps);
+  ParallelFor(num_steps, num_threads, [&](size_t s) {
+    tree->forward(values, interval.k_start + s, &poses[s], &twists[s]);
+  });
+
+  for (size_t s = 0; s < num_steps; s++) {
+    tree->insert(interval.k_start + s, poses[s], twists[s], &values);
   }
   return values;
 }
@@ -15,10 +15,14 @@
 
 #include <gtdynamics/config.h>
 #include <gtdynamics/universal_robot/Joint.h>
+#include <gtdynamics/universal_robot/KinematicTree.h>
 #include <gtdynamics/universal_robot/Link.h>
 #include <gtdynamics/universal_robot/RobotTypes.h>
+#include <gtdynamics/utils/Interval.h>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
@@ -54,6 +58,15 @@ class Robot {
   LinkMap name_to_link_;
   JointMap name_to_joint_;
 
+  /// Kinematic trees compiled on demand, keyed on root link id. Copies of a
+  /// robot share their links and joints, and hence also this cache.
+  struct KinematicTreeCache {
+    std::mutex mutex;
+    std::map<uint8_t, std::shared_ptr<const KinematicTree>> trees;
+  };
+  std::shared_ptr<KinematicTreeCache> tree_cache_ =
+      std::make_shared<KinematicTreeCache>();
+
  public:
   /** Default Constructor */
   Robot() {}
@@ -158,6 +171,34 @@ class Robot {
       const gtsam::Values &known_values, size_t t = 0,
       const std::optional<std::string> &prior_link_name = {}) const;
 
+  /**
+   * Calculate forward kinematics for all time steps in an interval, in one
+   * pass. The input is copied once, and all time steps are computed against
+   * it before the results are inserted, so the cost is linear in the length
+   * of the trajectory. Time steps can be distributed over threads.
+   *
+   * The same defaults and consistency checks as the single time step version
+   * apply to every time step.
+   *
+   * @param[in] known_values Values with joint angles, joint velocities, and
+   * (optionally) root link poses and twists, for all time steps
+   * @param[in] interval time steps k_start to k_end, inclusive
+   * @param[in] prior_link_name name of link with known pose & twist
+   * @param[in] num_threads number of threads, 0 for all hardware threads
+   * @return known_values with CoM poses and twists of all links added
+   */
+  gtsam::Values forwardKinematics(
+      const gtsam::Values &known_values, const Interval &interval,
+      const std::optional<std::string> &prior_link_name = {},
+      size_t num_threads = 1) const;
+
+  /**
+   * Return the kinematic tree rooted at the given link, which is compiled on
+   * first use and cached. Thread-safe.
+   */
+  std::shared_ptr<const KinematicTree> kinematicTree(
+      const LinkSharedPtr &root) const;
+
  private:
   /// Find root link for forward kinematics
   LinkSharedPtr findRootLink(
@@ -99,6 +99,13 @@ class DynamicsSymbol {
   /// Retrieve key index.
   inline uint64_t time() const { return t_; }
 
+  /// Return a copy of this symbol at another time step.
+  DynamicsSymbol withTime(uint64_t t) const {
+    DynamicsSymbol symbol(*this);
+    symbol.t_ = t;
+    return symbol;
+  }
+
   /// Print.
   void print(const std::string& s = "") const;
 
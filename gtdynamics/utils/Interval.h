@@ -12,6 +12,8 @@
  */
 
 #pragma once
+
+#include <cstddef>
 namespace gtdynamics {
 
 /// An interval from k_start to k_end.
@@ -0,0 +1,90 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  Parallel.h
+ * @brief Parallel loops over independent work items, using TBB if available.
+ */
+
+#pragma once
+
+#include <gtdynamics/config.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#ifdef GTDYNAMICS_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+namespace gtdynamics {
+
+/// Resolve a requested number of threads, where 0 means all hardware threads.
+inline size_t NumThreads(size_t num_threads) {
+  if (num_threads > 0) return num_threads;
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * Call `function(i)` for every i in [0, n), distributing the indices over up
+ * to `num_threads` threads (0 for all hardware threads). With a single thread
+ * the indices are processed in order on the calling thread.
+ *
+ * The calls must be independent, i.e., only write to storage owned by index
+ * i. If calls throw, the exception of the smallest such index is rethrown on
+ * the calling thread after all threads have finished.
+ */
+template <typename FUNCTION>
+void ParallelFor(size_t n, size_t num_threads, FUNCTION &&function) {
+  num_threads = std::min(NumThreads(num_threads), n);
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < n; ++i) function(i);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(n);
+  auto guarded = [&](size_t i) {
+    try {
+      function(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+#ifdef GTDYNAMICS_USE_TBB
+  tbb::task_arena arena(static_cast<int>(num_threads));
+  arena.execute([&] {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                      [&](const tbb::blocked_range<size_t> &range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                          guarded(i);
+                      });
+  });
+#else
+  // Contiguous blocks of indices, one per thread.
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t b = 0; b < num_threads; ++b) {
+    const size_t begin = n * b / num_threads, end = n * (b + 1) / num_threads;
+    threads.emplace_back([&guarded, begin, end] {
+      for (size_t i = begin; i < end; ++i) guarded(i);
+    });
+  }
+  for (auto &&thread : threads) thread.join();
+#endif
+
+  for (auto &&error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+}  // namespace gtdynamics
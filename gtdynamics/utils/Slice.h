@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace gtdynamics {
 
 /// A single discrete time slice.
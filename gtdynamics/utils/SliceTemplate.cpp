@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  SliceTemplate.cpp
+ * @brief Instantiate the factors of one time slice at other time steps.
+ */
+
+#include <gtdynamics/factors/ContactPointFactor.h>
+#include <gtdynamics/factors/JointLimitFactor.h>
+#include <gtdynamics/factors/JointMeasurementFactor.h>
+#include <gtdynamics/factors/JointTypedFactors.h>
+#include <gtdynamics/factors/MinTorqueFactor.h>
+#include <gtdynamics/factors/PreintegratedContactFactors.h>
+#include <gtdynamics/factors/RemappedFactor.h>
+#include <gtdynamics/factors/WrenchFactor.h>
+#include <gtdynamics/utils/DynamicsSymbol.h>
+#include <gtdynamics/utils/SliceTemplate.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <memory>
+#include <stdexcept>
+#include <typeinfo>
+
+using gtsam::Key;
+using gtsam::KeyVector;
+using gtsam::NoiseModelFactor;
+using gtsam::NonlinearFactorGraph;
+
+namespace gtdynamics {
+
+namespace {
+/// Whether the factor is exactly of one of the given classes.
+template <typename... FACTORS>
+bool IsOneOf(const gtsam::NonlinearFactor &factor) {
+  const std::type_info &type = typeid(factor);
+  return (... || (type == typeid(FACTORS)));
+}
+
+/// Whether the factor is a joint-typed factor, for any joint kernel.
+template <template <class> class... FACTORS>
+bool IsJointTyped(const gtsam::NonlinearFactor &factor) {
+  return IsOneOf<FACTORS<RevoluteJoint>..., FACTORS<PrismaticJoint>...,
+                 FACTORS<HelicalJoint>...>(factor);
+}
+
+/**
+ * Whether NonlinearFactor::rekey yields a correct copy of the factor, i.e.,
+ * the factor only reads its variables through keys(). The class is matched
+ * exactly, as a derived class may still capture keys of its own.
+ */
+bool IsRekeyable(const gtsam::NonlinearFactor &factor) {
+  using gtsam::BetweenFactor;
+  using gtsam::PriorFactor;
+  return IsJointTyped<TypedPoseFactor, TypedTwistFactor,
+                      TypedTwistAccelFactor, TypedWrenchEquivalenceFactor,
+                      TypedTorqueFactor>(factor) ||
+         IsOneOf<WrenchBalanceFactor, JointLimitFactor,
+                 JointMeasurementFactor, MinTorqueFactor, ContactPointFactor,
+                 ContactPoseFactor, PreintegratedPointContactFactor,
+                 PriorFactor<double>, PriorFactor<gtsam::Vector6>,
+                 PriorFactor<gtsam::Pose3>, BetweenFactor<double>,
+                 BetweenFactor<gtsam::Pose3>>(factor);
+}
+}  // namespace
+
+/* ************************************************************************* */
+Key ShiftTime(Key key, int offset) {
+  const DynamicsSymbol symbol(key);
+  const int64_t t = static_cast<int64_t>(symbol.time()) + offset;
+  if (t < 0) {
+    throw std::invalid_argument("ShiftTime: negative time index for key " +
+                                _GTDKeyFormatter(key));
+  }
+  return symbol.withTime(t);
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph SliceTemplate::instantiate(const Slice &slice) const {
+  if (slice.k == k_) return graph_;
+
+  const int offset = static_cast<int>(slice.k) - static_cast<int>(k_);
+  NonlinearFactorGraph graph;
+  graph.reserve(graph_.size());
+  for (auto &&factor : graph_) {
+    if (!factor) {
+      graph.push_back(factor);
+      continue;
+    }
+    KeyVector keys;
+    keys.reserve(factor->size());
+    for (Key key : factor->keys()) keys.push_back(ShiftTime(key, offset));
+
+    // Remap the shared original rather than wrapping a wrapper. Factors that
+    // are known to only use keys() are re-keyed clones, all other
+    // noise-model factors are wrapped, as they may capture their keys, e.g.,
+    // in an expression tree.
+    if (auto remapped = std::dynamic_pointer_cast<RemappedFactor>(factor)) {
+      graph.emplace_shared<RemappedFactor>(remapped->baseFactor(), keys);
+    } else if (IsRekeyable(*factor)) {
+      graph.push_back(factor->rekey(keys));
+    } else if (auto noise_model_factor =
+                   std::dynamic_pointer_cast<NoiseModelFactor>(factor)) {
+      graph.emplace_shared<RemappedFactor>(noise_model_factor, keys);
+    } else {
+      throw std::invalid_argument(
+          std::string("SliceTemplate: cannot instantiate factor of type ") +
+          typeid(*factor).name());
+    }
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph SliceTemplate::instantiate(
+    const Interval &interval) const {
+  NonlinearFactorGraph graph;
+  for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+    graph.add(instantiate(Slice(k)));
+  }
+  return graph;
+}
+
+}  // namespace gtdynamics
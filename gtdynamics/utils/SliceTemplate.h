@@ -0,0 +1,74 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020-2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  SliceTemplate.h
+ * @brief Instantiate the factors of one time slice at other time steps.
+ */
+
+#pragma once
+
+#include <gtdynamics/utils/Interval.h>
+#include <gtdynamics/utils/Slice.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+namespace gtdynamics {
+
+/**
+ * Shift the time index of a DynamicsSymbol key by an offset.
+ * Throws std::invalid_argument if the time index would become negative.
+ */
+gtsam::Key ShiftTime(gtsam::Key key, int offset);
+
+/**
+ * SliceTemplate holds the factors of a single time slice, built once, e.g.,
+ * with Kinematics::graph<Slice>, Statics::graph, or
+ * DynamicsGraph::dynamicsFactorGraph. Copies for other time steps are created
+ * by shifting the time index of every DynamicsSymbol key, instead of walking
+ * the robot again.
+ *
+ * Factors of the GTDynamics classes that only read their variables through
+ * keys(), e.g., the joint-typed factors and WrenchBalanceFactor, are cloned
+ * with NonlinearFactor::rekey. All other noise-model factors, which may
+ * capture their keys, e.g., in the expression tree of an ExpressionFactor,
+ * are wrapped in a RemappedFactor, which shares the template factor. Other
+ * factors throw std::invalid_argument.
+ *
+ * All keys of the template are shifted, including ones with a time index that
+ * differs from the template slice (e.g., collocation factors between k and
+ * k+1). Keys that do not encode a time step, e.g., phase keys, should hence
+ * not appear in a template.
+ */
+class SliceTemplate {
+ private:
+  gtsam::NonlinearFactorGraph graph_;
+  size_t k_;
+
+ public:
+  /**
+   * Constructor
+   * @param graph factors of the template slice
+   * @param slice time slice the factors were built for
+   */
+  SliceTemplate(const gtsam::NonlinearFactorGraph &graph, const Slice &slice)
+      : graph_(graph), k_(slice.k) {}
+
+  /// Time step of the template.
+  size_t k() const { return k_; }
+
+  /// Factors of the template.
+  const gtsam::NonlinearFactorGraph &graph() const { return graph_; }
+
+  /// Return the factors for another time slice.
+  gtsam::NonlinearFactorGraph instantiate(const Slice &slice) const;
+
+  /// Return the factors for all slices in an interval, in time order.
+  gtsam::NonlinearFactorGraph instantiate(const Interval &interval) const;
+};
+
+}  // namespace gtdynamics
@@ -20,10 +20,13 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
+using gtsam::Key;
 using gtsam::NonlinearFactorGraph;
+using gtsam::Ordering;
 using gtsam::Point3;
 using gtsam::SharedNoiseModel;
 using gtsam::Values;
@@ -35,6 +38,64 @@ using std::vector;
 
 namespace gtdynamics {
 
+namespace {
+/// Number the phases [lo, hi[ in post order of their nested dissection: the
+/// interiors of both halves, then the boundary between them.
+void Dissect(size_t lo, size_t hi, vector<int> *interior,
+             vector<int> *separator, int *next) {
+  if (hi - lo == 1) {
+    (*interior)[lo] = (*next)++;
+    return;
+  }
+  const size_t mid = (lo + hi) / 2;
+  Dissect(lo, mid, interior, separator, next);
+  Dissect(mid, hi, interior, separator, next);
+  (*separator)[mid - 1] = (*next)++;
+}
+}  // namespace
+
+Ordering Trajectory::nestedDissectionOrdering(
+    const NonlinearFactorGraph &graph) const {
+  const size_t num_phases = numPhases();
+  if (num_phases == 0) return Ordering::Colamd(graph);
+
+  vector<int> interior(num_phases), separator(num_phases, -1);
+  int next = 0;
+  Dissect(0, num_phases, &interior, &separator, &next);
+
+  // The time field of a phase duration key is the phase, not a time step.
+  map<Key, size_t> phase_keys;
+  for (size_t p = 0; p < num_phases; p++) phase_keys.emplace(PhaseKey(p), p);
+
+  const vector<int> final_timesteps = finalTimeSteps();
+  auto group = [&](Key key) {
+    auto it = phase_keys.find(key);
+    if (it != phase_keys.end()) return interior[it->second];
+    const int k = static_cast<int>(DynamicsSymbol(key).time());
+    const size_t p = std::min<size_t>(
+        std::lower_bound(final_timesteps.begin(), final_timesteps.end(), k) -
+            final_timesteps.begin(),
+        num_phases - 1);
+    if (k == final_timesteps[p] && p + 1 < num_phases) return separator[p];
+    return interior[p];
+  };
+
+  gtsam::FastMap<Key, int> groups;
+  std::set<int> used;
+  for (Key key : graph.keys()) {
+    groups[key] = group(key);
+    used.insert(groups[key]);
+  }
+
+  // Groups have to be consecutive integers.
+  map<int, int> consecutive;
+  for (int g : used) {
+    consecutive.emplace(g, static_cast<int>(consecutive.size()));
+  }
+  for (auto &&it : groups) it.second = consecutive.at(it.second);
+  return Ordering::ColamdConstrained(graph, groups);
+}
+
 vector<NonlinearFactorGraph> Trajectory::getTransitionGraphs(
     const Robot &robot, const DynamicsGraph &graph_builder, double mu) const {
   vector<NonlinearFactorGraph> transition_graphs;
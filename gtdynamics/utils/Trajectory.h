@@ -20,6 +20,8 @@
 #include <gtdynamics/utils/Phase.h>
 #include <gtdynamics/utils/WalkCycle.h>
 #include <gtdynamics/utils/Initializer.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/nonlinear/LevenbergMarquardtParams.h>
 
 namespace gtdynamics {
 
@@ -183,6 +185,37 @@ class Trajectory {
    */
   int getEndTimeStep(size_t p) const { return finalTimeSteps()[p]; }
 
+  /**
+   * @fn Nested-dissection ordering of a multi-phase trajectory graph.
+   *
+   * The horizon is recursively split in half at phase transitions. The
+   * variables at the end time step of a phase, shared with the next phase,
+   * form the separator of the split; all other variables of a phase,
+   * including its duration PhaseKey(p), are its interior. Interiors are
+   * eliminated before the separators that split them, and within each group
+   * the variables are ordered with COLAMD. The phases are then independent
+   * subtrees of the Bayes tree, which multifrontal elimination can process in
+   * parallel.
+   *
+   * @param[in] graph  Factor graph of the trajectory, e.g., as returned by
+   *                   multiPhaseFactorGraph.
+   * @return Elimination ordering of all keys in the graph.
+   */
+  gtsam::Ordering nestedDissectionOrdering(
+      const gtsam::NonlinearFactorGraph &graph) const;
+
+  /**
+   * @fn Set the nested-dissection ordering as the ordering used by LM.
+   * @param[in] graph        Factor graph of the trajectory.
+   * @param[in,out] params   LM parameters, e.g., lm_parameters in
+   *                         OptimizationParameters.
+   */
+  void setNestedDissectionOrdering(
+      const gtsam::NonlinearFactorGraph &graph,
+      gtsam::LevenbergMarquardtParams *params) const {
+    params->setOrdering(nestedDissectionOrdering(graph));
+  }
+
   /**
    * @fn Generates a PointGoalFactor object
    * @param[in] robot             Robot specification from URDF/SDF.
@@ -166,4 +166,20 @@ Vector6 Wrench(const Values &values, int i, int j, int t) {
   return at<Vector6>(values, WrenchKey(i, j, t));
 }
 
+/* ************************************************************************* */
+Values ShiftValues(const Values &values, int offset,
+                   const gtsam::KeySet &static_keys) {
+  Values shifted;
+  for (const gtsam::Key &key : values.keys()) {
+    if (static_keys.count(key)) {
+      shifted.insert(key, values.at(key));
+      continue;
+    }
+    const DynamicsSymbol symbol(key);
+    const int64_t t = static_cast<int64_t>(symbol.time()) + offset;
+    if (t >= 0) shifted.insert(symbol.withTime(t), values.at(key));
+  }
+  return shifted;
+}
+
 }  // namespace gtdynamics
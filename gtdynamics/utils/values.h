@@ -83,6 +83,11 @@ inline gtsam::Key ContactWrenchKey(int i, int c, int k = 0) {
   return DynamicsSymbol::LinkJointSymbol("C", i, c, k);
 }
 
+/// Shorthand for c_i_k, for the contact frame on i-th link at time step k.
+inline gtsam::Key ContactPoseKey(int i, int k = 0) {
+  return DynamicsSymbol::LinkSymbol("c", i, k);
+}
+
 /* Shorthand for dt_k, for duration for timestep dt_k during phase k. */
 inline gtsam::Key PhaseKey(int k) {
   return DynamicsSymbol::SimpleSymbol("dt", k);
@@ -451,4 +456,20 @@ gtsam::Vector Wrench(const gtsam::VectorValues &values, int i, int j,
  */
 gtsam::Vector6 Wrench(const gtsam::Values &values, int i, int j, int t = 0);
 
+/**
+ * @brief Shift the time index of all variables by an offset, e.g., to move a
+ * solution to the next window of a receding-horizon problem.
+ *
+ * Variables whose time index would become negative are dropped. Keys that do
+ * not encode a time step, e.g., phase keys, are copied unchanged if they are
+ * listed in static_keys. All other keys must be DynamicsSymbols.
+ *
+ * @param values Values with DynamicsSymbol keys.
+ * @param offset Offset added to every time index.
+ * @param static_keys Keys that are copied without shifting.
+ * @return gtsam::Values
+ */
+gtsam::Values ShiftValues(const gtsam::Values &values, int offset,
+                          const gtsam::KeySet &static_keys = {});
+
 }  // namespace gtdynamics
@@ -0,0 +1,131 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testAnalyticIK.cpp
+ * @brief Test closed-form inverse kinematics for legs.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/kinematics/AnalyticIK.h>
+#include <gtdynamics/kinematics/Kinematics.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::Point3;
+using gtsam::Values;
+
+namespace {
+// Forward kinematics with the base at rest, and the given joint angles.
+Values RestFK(const Robot &robot, const std::string &base_name,
+              const std::map<std::string, double> &joint_angles) {
+  Values known;
+  const auto base = robot.link(base_name);
+  InsertPose(&known, base->id(), 0, base->bMcom());
+  for (auto &&[name, q] : joint_angles) {
+    InsertJointAngle(&known, robot.joint(name)->id(), 0, q);
+  }
+  return robot.forwardKinematics(known, 0, base_name);
+}
+}  // namespace
+
+TEST(KinematicChain, A1) {
+  const Robot robot =
+      CreateRobotFromFile(kUrdfPath + std::string("a1/a1.urdf"));
+  const auto chain = KinematicChain(robot, "trunk", "FR_lower");
+  EXPECT_LONGS_EQUAL(3, chain.size());
+  EXPECT(chain.front()->name() == "FR_hip_joint");
+  EXPECT(chain.back()->name() == "FR_lower_joint");
+  THROWS_EXCEPTION(KinematicChain(robot, "FL_hip", "FR_lower"));
+}
+
+TEST(ThreeDofLegIK, A1) {
+  const Robot robot =
+      CreateRobotFromFile(kUrdfPath + std::string("a1/a1.urdf"));
+  const auto registry = AnalyticIKRegistry::Legs(robot, "trunk");
+  EXPECT_LONGS_EQUAL(4, registry.size());
+  const auto solver =
+      std::dynamic_pointer_cast<const ThreeDofLegIK>(registry.find("FR_lower"));
+  CHECK(solver);
+  EXPECT(!registry.find("trunk"));
+
+  // Goal reached with known joint angles.
+  const gtsam::Vector3 q(0.1, 0.6, -1.2);
+  const Point3 point_in_tip(0, 0, -0.1);
+  std::map<std::string, double> joint_angles;
+  for (size_t i = 0; i < 3; i++) joint_angles[solver->jointNames()[i]] = q(i);
+  const Values fk = RestFK(robot, "trunk", joint_angles);
+  const auto trunk = robot.link("trunk"), tip = robot.link("FR_lower");
+  const Point3 goal = trunk->bMcom().transformTo(
+      Pose(fk, tip->id()).transformFrom(point_in_tip));
+  EXPECT(assert_equal(goal, solver->forwardPoint(q, point_in_tip), 1e-9));
+
+  // All solutions reach the goal, and one of them is the original.
+  const auto solutions = solver->inversePoint(point_in_tip, goal);
+  CHECK(!solutions.empty());
+  bool found = false;
+  for (auto &&solution : solutions) {
+    EXPECT(assert_equal(goal, solver->forwardPoint(solution, point_in_tip),
+                        1e-9));
+    found = found || (solution - q).norm() < 1e-6;
+  }
+  EXPECT(found);
+
+  // Too far away.
+  EXPECT(solver->inversePoint(point_in_tip, Point3(0, 0, -10)).empty());
+  THROWS_EXCEPTION(solver->inversePose(gtsam::Pose3()));
+}
+
+TEST(Kinematics, AnalyticInverse) {
+  const Robot robot =
+      CreateRobotFromFile(kUrdfPath + std::string("vision60.urdf"));
+  const auto registry = std::make_shared<const AnalyticIKRegistry>(
+      AnalyticIKRegistry::Legs(robot, "body"));
+  EXPECT_LONGS_EQUAL(4, registry->size());
+
+  // Goals for the feet, from a known stance.
+  std::map<std::string, double> joint_angles;
+  for (auto &&joint : robot.joints()) {
+    joint_angles[joint->name()] = 0.1 * (joint->id() % 3) + 0.2;
+  }
+  const Values fk = RestFK(robot, "body", joint_angles);
+  const Point3 contact_in_com(0.14, 0, 0);
+  ContactGoals contact_goals;
+  for (auto &&name : {"lower0", "lower1", "lower2", "lower3"}) {
+    const auto link = robot.link(name);
+    contact_goals.emplace_back(
+        PointOnLink{link, contact_in_com},
+        Pose(fk, link->id()).transformFrom(contact_in_com));
+  }
+
+  KinematicsParameters parameters;
+  parameters.analytic_ik = registry;
+  parameters.analytic_ik_only = true;
+  Kinematics kinematics(parameters);
+  const auto analytic = kinematics.analyticInverse(Slice(3), robot,
+                                                   contact_goals);
+  CHECK(analytic);
+  EXPECT_LONGS_EQUAL(robot.numJoints() + robot.numLinks(), analytic->size());
+  for (const ContactGoal &goal : contact_goals) {
+    EXPECT(goal.satisfied(*analytic, 3, 1e-9));
+  }
+  EXPECT(assert_equal(*analytic,
+                      kinematics.inverse(Slice(3), robot, contact_goals)));
+
+  // No solver for the base link.
+  ContactGoals base_goal{{{robot.link("body"), Point3()}, Point3()}};
+  EXPECT(!kinematics.analyticInverse(Slice(3), robot, base_goal));
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
@@ -420,6 +420,44 @@ TEST(dynamicsTrajectoryFG, simple_urdf_eq_mass) {
   EXPECT(assert_equal(3.0, JointAccel(mp_trapezoidal_result, j, 2)));
 }
 
+// Check that two graphs have the same factors, in the same order.
+bool assert_same_factors(const NonlinearFactorGraph& expected,
+                         const NonlinearFactorGraph& actual,
+                         const Values& values) {
+  if (expected.size() != actual.size()) return false;
+  for (size_t i = 0; i < expected.size(); i++) {
+    if (expected[i]->keys() != actual[i]->keys()) return false;
+    if (!assert_equal(expected[i]->error(values), actual[i]->error(values),
+                      1e-9))
+      return false;
+  }
+  return true;
+}
+
+// Building the time steps on multiple threads gives the same graph.
+TEST(dynamicsTrajectoryFG, parallel) {
+  auto robot =
+      CreateRobotFromFile(kSdfPath + std::string("spider.sdf"), "spider");
+  DynamicsGraph graph_builder(gtsam::Vector3(0, 0, -9.8));
+  const int num_steps = 10;
+  Values values =
+      Initializer().ZeroValuesTrajectory(robot, num_steps, 2, 0.1);
+
+  auto serial = graph_builder.trajectoryFG(robot, num_steps, 0.01);
+  auto parallel =
+      graph_builder.trajectoryFG(robot, num_steps, 0.01, Trapezoidal, {}, {}, 4);
+  EXPECT(assert_same_factors(serial, parallel, values));
+
+  vector<int> phase_steps{4, 6};
+  vector<NonlinearFactorGraph> transition_graphs{
+      graph_builder.dynamicsFactorGraph(robot, 4)};
+  auto mp_serial = graph_builder.multiPhaseTrajectoryFG(robot, phase_steps,
+                                                        transition_graphs);
+  auto mp_parallel = graph_builder.multiPhaseTrajectoryFG(
+      robot, phase_steps, transition_graphs, Trapezoidal, {}, {}, 4);
+  EXPECT(assert_same_factors(mp_serial, mp_parallel, values));
+}
+
 // Test contacts in dynamics graph.
 TEST(dynamicsFactorGraph_Contacts, dynamics_graph_simple_rr) {
   // Load the robot from urdf file
@@ -235,6 +235,40 @@ TEST(EqualityConstraint, FactorZeroErrorConstraint) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(*merit_factor, values2, 1e-7, 1e-5);
 }
 
+// Merit factors updated in place agree with the ones created for given mu and
+// bias.
+TEST(EqualityConstraint, CreateMeritFactors) {
+  Vector2_ x1_vec_expr(x1_key);
+  Vector2_ x2_vec_expr(x2_key);
+  EqualityConstraints constraints;
+  constraints.emplace_shared<VectorExpressionEquality<2>>(
+      x1_vec_expr + x2_vec_expr, Vector2(0.1, 0.5));
+  NonlinearFactorGraph graph;
+  auto noise = noiseModel::Diagonal::Sigmas(Vector2(0.5, 0.1));
+  graph.emplace_shared<BetweenFactor<Vector2>>(x1_key, x2_key, Vector2(1, 1),
+                                               noise);
+  constraints.add(ConstraintsFromGraph(graph));
+
+  Values values;
+  values.insert(x1_key, Vector2(0, 0));
+  values.insert(x2_key, Vector2(2, 3));
+
+  auto merit_factors = CreateMeritFactors(constraints);
+  EXPECT_LONGS_EQUAL(2, merit_factors.size());
+  for (double mu : {1.0, 4.0}) {
+    Vector bias = (Vector(2) << 1, 0.5).finished() * mu;
+    for (size_t i = 0; i < constraints.size(); i++) {
+      merit_factors[i]->setPenalty(mu);
+      merit_factors[i]->setBias(bias);
+      auto expected = constraints[i]->createFactor(mu, bias);
+      EXPECT(expected->noiseModel()->equals(*merit_factors[i]->noiseModel()));
+      EXPECT_DOUBLES_EQUAL(expected->error(values),
+                           merit_factors[i]->error(values), 1e-9);
+      EXPECT_CORRECT_FACTOR_JACOBIANS(*merit_factors[i], values, 1e-7, 1e-5);
+    }
+  }
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testFixedChain.cpp
+ * @brief Test the fixed-size chain against the dynamic Chain class.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/dynamics/FixedChain.h>
+#include <gtdynamics/optimizer/EqualityConstraint.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/expressionTesting.h>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::Matrix;
+using gtsam::Point3;
+using gtsam::Pose3;
+using gtsam::Rot3;
+using gtsam::Vector3;
+using gtsam::Vector6;
+
+namespace {
+// A four-joint chain with arbitrary, non-parallel screw axes.
+std::vector<Chain> Links() {
+  std::vector<Chain> chains;
+  const std::vector<Pose3> poses{
+      Pose3(Rot3::Ypr(0.1, 0.2, -0.3), Point3(0.5, 0, 1)),
+      Pose3(Rot3::Rx(0.4), Point3(0, 1, 0.2)),
+      Pose3(Rot3::Ry(-0.5), Point3(0.3, -0.2, 0.8)),
+      Pose3(Rot3::Rz(0.7), Point3(1, 0, 0))};
+  const std::vector<Vector6> axes{
+      (Vector6() << 0, 0, 1, 0, 0.5, 0).finished(),
+      (Vector6() << 1, 0, 0, 0, 0, 0.2).finished(),
+      (Vector6() << 0, 1, 0, 0.3, 0, 0).finished(),
+      (Vector6() << 0, 0, 0, 0, 0, 1).finished()};
+  for (size_t i = 0; i < poses.size(); ++i) {
+    chains.emplace_back(poses[i], Matrix(axes[i]));
+  }
+  return chains;
+}
+}  // namespace
+
+// Composition, forward kinematics and Jacobian agree with Chain.
+TEST(FixedChain, Poe) {
+  auto links = Links();
+  Chain chain = Chain::compose(links);
+  const FixedChain<4> fixed(chain);
+
+  // Composing fixed-size chains gives the same chain.
+  const FixedChain<1> a(links[0]), b(links[1]), c(links[2]), d(links[3]);
+  const FixedChain<4> composed = (a * b) * (c * d);
+  EXPECT(assert_equal(chain.sMb(), composed.sMb(), 1e-9));
+  EXPECT(assert_equal(chain.axes(), Matrix(composed.axes()), 1e-9));
+
+  const Pose3 fTe(Rot3::Rz(0.2), Point3(0, 0, 0.1));
+  const gtsam::Vector4 q(0.3, -0.7, 1.1, 0.4);
+  Matrix expected_J;
+  const Pose3 expected = chain.poe(q, fTe, expected_J);
+
+  FixedChain<4>::Axes J;
+  EXPECT(assert_equal(expected, fixed.poe(q, fTe, J), 1e-9));
+  EXPECT(assert_equal(expected_J, Matrix(J), 1e-9));
+  EXPECT(assert_equal(expected, fixed.poe(q, fTe), 1e-9));
+}
+
+// Jacobians of the dynamical equality for a four-joint chain.
+TEST(FixedChain, DynamicalEquality) {
+  auto links = Links();
+  const FixedChain<4> chain(Chain::compose(links));
+  using Vector4 = gtsam::Vector4;
+  const Vector6 wrench = (Vector6() << 1, -2, 0.5, 3, 0.2, -1).finished();
+  const Vector4 angles(0.3, -0.7, 1.1, 0.4), torques(0.1, 0.2, -0.3, 0.4);
+
+  Eigen::Matrix<double, 4, 6> H_wrench;
+  Eigen::Matrix<double, 4, 4> H_angles, H_torques;
+  chain.dynamicalEquality(wrench, angles, torques, H_wrench, H_angles,
+                          H_torques);
+
+  auto f = [&](const Vector6 &F, const Vector4 &q, const Vector4 &tau) {
+    return chain.dynamicalEquality(F, q, tau);
+  };
+  EXPECT(assert_equal(
+      gtsam::numericalDerivative31<Vector4, Vector6, Vector4, Vector4>(
+          f, wrench, angles, torques),
+      Matrix(H_wrench), 1e-7));
+  EXPECT(assert_equal(
+      gtsam::numericalDerivative32<Vector4, Vector6, Vector4, Vector4>(
+          f, wrench, angles, torques),
+      Matrix(H_angles), 1e-7));
+  EXPECT(assert_equal(
+      gtsam::numericalDerivative33<Vector4, Vector6, Vector4, Vector4>(
+          f, wrench, angles, torques),
+      Matrix(H_torques), 1e-7));
+}
+
+// Same constraint as TEST(Chain, ChainConstraint), built from joints.
+TEST(FixedChain, ChainConstraint) {
+  Robot robot = CreateRobotFromFile(
+      kSdfPath + std::string("test/simple_rrr.sdf"), "simple_rrr_sdf");
+  const auto chain = FixedChain<3>::FromJoints(robot.joints());
+  EXPECT(assert_equal(Pose3(Rot3(), Point3(0, 0, 1.6)), chain.sMb(), 1e-6));
+  THROWS_EXCEPTION(FixedChain<2>::FromJoints(robot.joints()));
+
+  const gtsam::Key wrench_key = WrenchKey(0, 1, 0);
+  auto expression = chain.chainConstraint(robot.joints(), wrench_key, 0);
+
+  gtsam::Values values;
+  for (auto &&joint : robot.joints()) {
+    InsertJointAngle(&values, joint->id(), 0, 0.0);
+    InsertTorque(&values, joint->id(), 0, 0.0);
+  }
+  InsertWrench(&values, 0, 1, 0, Vector6::Ones());
+
+  auto constraint = VectorExpressionEquality<3>(expression, Vector3::Ones());
+  EXPECT(assert_equal(Vector3(1, 1.9, 1.3), constraint(values), 1e-6));
+  EXPECT_CORRECT_EXPRESSION_JACOBIANS(expression, values, 1e-7, 1e-5);
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
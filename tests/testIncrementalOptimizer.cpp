@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testIncrementalOptimizer.cpp
+ * @brief Test incremental optimization with marginalization of old steps.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/optimizer/IncrementalOptimizer.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <cmath>
+
+using namespace gtdynamics;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+namespace example {
+const auto model = gtsam::noiseModel::Isotropic::Sigma(1, 0.1);
+
+// Factors of time step k of a joint angle trajectory tracking a sinusoid,
+// with a static phase duration variable.
+NonlinearFactorGraph slice(int k) {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<gtsam::PriorFactor<double>>(JointAngleKey(0, k),
+                                                   std::sin(0.3 * k), model);
+  if (k > 0) {
+    graph.emplace_shared<gtsam::BetweenFactor<double>>(
+        JointAngleKey(0, k - 1), JointAngleKey(0, k), 0.1, model);
+  } else {
+    graph.emplace_shared<gtsam::PriorFactor<double>>(PhaseKey(0), 0.5, model);
+  }
+  return graph;
+}
+}  // namespace example
+
+TEST(IncrementalOptimizer, KeepAll) {
+  IncrementalOptimizer optimizer(IncrementalParameters(), {PhaseKey(0)});
+  NonlinearFactorGraph graph;
+  Values values;
+  for (int k = 0; k < 10; k++) {
+    Values new_values;
+    InsertJointAngle(&new_values, 0, k, 0.0);
+    if (k == 0) new_values.insert(PhaseKey(0), 0.0);
+    optimizer.update(example::slice(k), new_values);
+    graph.add(example::slice(k));
+    values.insert(new_values);
+  }
+  EXPECT_LONGS_EQUAL(11, optimizer.estimate().size());
+  EXPECT_LONGS_EQUAL(0, *optimizer.startTime());
+  EXPECT_LONGS_EQUAL(9, *optimizer.endTime());
+
+  const Values batch =
+      gtsam::LevenbergMarquardtOptimizer(graph, values).optimize();
+  EXPECT(gtsam::assert_equal(batch, optimizer.estimate(), 1e-6));
+}
+
+TEST(IncrementalOptimizer, Marginalize) {
+  const size_t lag = 4, stride = 3;
+  IncrementalOptimizer optimizer(IncrementalParameters(lag, stride),
+                                 {PhaseKey(0)});
+  NonlinearFactorGraph graph;
+  Values values;
+  for (int k = 0; k < 20; k++) {
+    Values new_values;
+    InsertJointAngle(&new_values, 0, k, 0.0);
+    if (k == 0) new_values.insert(PhaseKey(0), 0.0);
+    optimizer.update(example::slice(k), new_values);
+    graph.add(example::slice(k));
+    values.insert(new_values);
+
+    // The window never grows beyond the lag plus the stride.
+    const Values estimate = optimizer.estimate();
+    EXPECT(estimate.size() <= lag + stride);
+    EXPECT(estimate.exists(PhaseKey(0)));
+    EXPECT(*optimizer.endTime() + 1 - *optimizer.startTime() < lag + stride);
+
+    // The problem is linear, so marginalization is exact.
+    const Values batch =
+        gtsam::LevenbergMarquardtOptimizer(graph, values).optimize();
+    for (const auto &key : estimate.keys()) {
+      EXPECT_DOUBLES_EQUAL(batch.at<double>(key), estimate.at<double>(key),
+                           1e-6);
+    }
+  }
+  EXPECT_LONGS_EQUAL(15, *optimizer.startTime());
+  EXPECT_LONGS_EQUAL(6, optimizer.estimate().size());
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
@@ -0,0 +1,164 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testJointTypedFactors.cpp
+ * @brief Test joint factors specialized on the joint type against the joint
+ * constraint expressions.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/factors/JointTypedFactors.h>
+#include <gtdynamics/universal_robot/HelicalJoint.h>
+#include <gtdynamics/universal_robot/Link.h>
+#include <gtdynamics/universal_robot/PrismaticJoint.h>
+#include <gtdynamics/universal_robot/RevoluteJoint.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/factorTesting.h>
+
+#include <vector>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::Matrix;
+using gtsam::Point3;
+using gtsam::Pose3;
+using gtsam::Rot3;
+using gtsam::Values;
+using gtsam::Vector3;
+using gtsam::Vector6;
+
+namespace example {
+const auto cost_model = gtsam::noiseModel::Unit::Create(6);
+const auto torque_model = gtsam::noiseModel::Unit::Create(1);
+
+// Two links, with a joint at an arbitrary pose in between.
+const gtsam::Matrix3 inertia = Vector3(3, 2, 1).asDiagonal();
+const auto l1 = std::make_shared<Link>(
+    Link(1, "l1", 100, inertia, Pose3(Rot3::Rz(0.3), Point3(0, 0, 1)),
+         Pose3()));
+const auto l2 = std::make_shared<Link>(
+    Link(2, "l2", 100, inertia, Pose3(Rot3::Ry(-0.2), Point3(1, 0.5, 2)),
+         Pose3()));
+const Pose3 bMj(Rot3::Ypr(0.1, 0.2, -0.3), Point3(0.5, 0, 1.5));
+const Vector3 axis = Vector3(1, 2, 3).normalized();
+
+const JointConstSharedPtr revolute =
+    std::make_shared<const RevoluteJoint>(1, "j1", bMj, l1, l2, axis);
+const JointConstSharedPtr prismatic =
+    std::make_shared<const PrismaticJoint>(1, "j1", bMj, l1, l2, axis);
+const JointConstSharedPtr helical =
+    std::make_shared<const HelicalJoint>(1, "j1", bMj, l1, l2, axis, 0.5);
+
+// Arbitrary values for all variables of the joint factors at time 0.
+Values values() {
+  Values x;
+  InsertPose(&x, 1, Pose3(Rot3::Ypr(0.4, -0.1, 0.2), Point3(1, 2, 3)));
+  InsertPose(&x, 2, Pose3(Rot3::Ypr(-0.3, 0.5, 0.1), Point3(2, 1, 3)));
+  InsertTwist(&x, 1, (Vector6() << 0.1, -0.2, 0.3, 1, 0.5, -1).finished());
+  InsertTwist(&x, 2, (Vector6() << -0.4, 0.1, 0.2, 0, 1, 2).finished());
+  InsertTwistAccel(&x, 1, (Vector6() << 1, 0, -1, 2, 0.3, 0).finished());
+  InsertTwistAccel(&x, 2, (Vector6() << 0, 2, 1, -1, 0, 0.5).finished());
+  InsertWrench(&x, 1, 1, (Vector6() << 1, 2, 3, 4, 5, 6).finished());
+  InsertWrench(&x, 2, 1, (Vector6() << -2, 1, 0, 3, -1, 2).finished());
+  InsertJointAngle(&x, 1, 0.7);
+  InsertJointVel(&x, 1, -1.3);
+  InsertJointAccel(&x, 1, 2.1);
+  InsertTorque(&x, 1, 0.4);
+  return x;
+}
+}  // namespace example
+
+// Check error and Jacobians key by key, since the key order differs.
+template <typename T>
+bool assert_same_factor(const gtsam::ExpressionFactor<T> &expected,
+                        const gtsam::NoiseModelFactor &actual,
+                        const Values &x) {
+  std::vector<Matrix> H_expected(expected.size()), H_actual(actual.size());
+  if (!assert_equal(expected.unwhitenedError(x, &H_expected),
+                    actual.unwhitenedError(x, &H_actual), 1e-9)) {
+    return false;
+  }
+  if (expected.size() != actual.size()) return false;
+  for (size_t i = 0; i < actual.size(); i++) {
+    const auto it = expected.find(actual.keys()[i]);
+    if (it == expected.end()) return false;
+    if (!assert_equal(H_expected[it - expected.begin()], H_actual[i], 1e-9)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class JOINT>
+void CheckJointFactors(const JointConstSharedPtr &joint, TestResult &result_,
+                       const std::string &name_) {
+  using gtsam::ExpressionFactor;
+  const Values x = example::values();
+  const auto &model = example::cost_model;
+
+  TypedPoseFactor<JOINT> pose_factor(model, joint, 0);
+  EXPECT(assert_same_factor(ExpressionFactor<Vector6>(model, Vector6::Zero(),
+                                                      joint->poseConstraint()),
+                            pose_factor, x));
+  EXPECT_CORRECT_FACTOR_JACOBIANS(pose_factor, x, 1e-7, 1e-5);
+
+  TypedTwistFactor<JOINT> twist_factor(model, joint, 0);
+  EXPECT(assert_same_factor(ExpressionFactor<Vector6>(model, Vector6::Zero(),
+                                                      joint->twistConstraint()),
+                            twist_factor, x));
+  EXPECT_CORRECT_FACTOR_JACOBIANS(twist_factor, x, 1e-7, 1e-5);
+
+  TypedTwistAccelFactor<JOINT> accel_factor(model, joint, 0);
+  EXPECT(assert_same_factor(
+      ExpressionFactor<Vector6>(model, Vector6::Zero(),
+                                joint->twistAccelConstraint()),
+      accel_factor, x));
+  EXPECT_CORRECT_FACTOR_JACOBIANS(accel_factor, x, 1e-7, 1e-5);
+
+  TypedWrenchEquivalenceFactor<JOINT> wrench_factor(model, joint, 0);
+  EXPECT(assert_same_factor(
+      ExpressionFactor<Vector6>(model, Vector6::Zero(),
+                                joint->wrenchEquivalenceConstraint()),
+      wrench_factor, x));
+  EXPECT_CORRECT_FACTOR_JACOBIANS(wrench_factor, x, 1e-7, 1e-5);
+
+  TypedTorqueFactor<JOINT> torque_factor(example::torque_model, joint, 0);
+  EXPECT(assert_same_factor(
+      ExpressionFactor<double>(example::torque_model, 0.0,
+                               joint->torqueConstraint()),
+      torque_factor, x));
+  EXPECT_CORRECT_FACTOR_JACOBIANS(torque_factor, x, 1e-7, 1e-5);
+}
+
+TEST(JointTypedFactors, Revolute) {
+  CheckJointFactors<RevoluteJoint>(example::revolute, result_, name_);
+}
+
+TEST(JointTypedFactors, Prismatic) {
+  CheckJointFactors<PrismaticJoint>(example::prismatic, result_, name_);
+}
+
+TEST(JointTypedFactors, Helical) {
+  CheckJointFactors<HelicalJoint>(example::helical, result_, name_);
+}
+
+// The factory dispatches on the joint type.
+TEST(JointTypedFactors, MakeTypedJointFactor) {
+  auto factor = MakeTypedJointFactor<TypedTwistFactor>(
+      example::prismatic, example::cost_model, example::prismatic, size_t(3));
+  EXPECT(std::dynamic_pointer_cast<TypedTwistFactor<PrismaticJoint>>(factor));
+  EXPECT(factor->keys()[0] == TwistKey(1, 3));
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
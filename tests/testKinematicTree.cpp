@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testKinematicTree.cpp
+ * @brief Test the precompiled kinematic tree used for forward kinematics.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/universal_robot/KinematicTree.h>
+#include <gtdynamics/universal_robot/Robot.h>
+#include <gtdynamics/universal_robot/RobotModels.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <cmath>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::Pose3;
+using gtsam::Values;
+using gtsam::Vector6;
+
+// Every link of a tree-structured robot is reached exactly once, after its
+// parent.
+TEST(KinematicTree, A1Structure) {
+  Robot robot =
+      CreateRobotFromFile(kUrdfPath + std::string("a1/a1.urdf"), "", true);
+  KinematicTree tree(robot.link("trunk"));
+
+  EXPECT_LONGS_EQUAL(robot.numLinks(), tree.size());
+  EXPECT_LONGS_EQUAL(0, tree.loopJoints().size());
+  EXPECT(tree.root() == robot.link("trunk"));
+  EXPECT(tree.joints()[0] == nullptr);
+  for (size_t k = 1; k < tree.size(); ++k) {
+    const int p = tree.parents()[k];
+    EXPECT(p >= 0 && p < static_cast<int>(k));
+    EXPECT(tree.joints()[k]->otherLink(tree.links()[k]) == tree.links()[p]);
+  }
+}
+
+// The flat-array pass agrees with chaining the joint transforms.
+TEST(KinematicTree, Forward) {
+  Robot robot =
+      CreateRobotFromFile(kSdfPath + std::string("spider.sdf"), "spider");
+  // Root the tree at a foot, so that joints are traversed in both directions.
+  const auto root = robot.link("tarsus_1_L1");
+  KinematicTree tree(root);
+
+  const Pose3 wTroot(gtsam::Rot3::Ypr(0.1, -0.2, 0.3),
+                     gtsam::Point3(1.0, 2.0, 0.5));
+  const Vector6 V_root =
+      (Vector6() << 0.1, -0.2, 0.3, 0.5, 0.0, -0.4).finished();
+  std::vector<double> q(tree.size(), 0.0), q_dot(tree.size(), 0.0);
+  for (size_t k = 1; k < tree.size(); ++k) {
+    q[k] = 0.3 * std::sin(k);
+    q_dot[k] = 0.2 * std::cos(k);
+  }
+
+  std::vector<Pose3> poses;
+  std::vector<Vector6> twists;
+  tree.forward(wTroot, V_root, q, q_dot, &poses, &twists);
+  EXPECT_LONGS_EQUAL(tree.size(), poses.size());
+  EXPECT_LONGS_EQUAL(tree.size(), twists.size());
+
+  for (size_t k = 1; k < tree.size(); ++k) {
+    const int p = tree.parents()[k];
+    const auto expected = tree.joints()[k]->otherPoseTwist(
+        tree.links()[p], poses[p], twists[p], q[k], q_dot[k]);
+    EXPECT(assert_equal(expected.first, poses[k], 1e-9));
+    EXPECT(assert_equal(expected.second, twists[k], 1e-9));
+  }
+
+  // The Values adapter gives the same result.
+  Values values;
+  InsertPose(&values, root->id(), 0, wTroot);
+  InsertTwist(&values, root->id(), 0, V_root);
+  for (size_t k = 1; k < tree.size(); ++k) {
+    InsertJointAngle(&values, tree.joints()[k]->id(), 0, q[k]);
+    InsertJointVel(&values, tree.joints()[k]->id(), 0, q_dot[k]);
+  }
+  Values fk = robot.forwardKinematics(values, 0, root->name());
+  for (size_t k = 0; k < tree.size(); ++k) {
+    EXPECT(assert_equal(poses[k], Pose(fk, tree.links()[k]->id()), 1e-9));
+    EXPECT(assert_equal(twists[k], Twist(fk, tree.links()[k]->id()), 1e-9));
+  }
+}
+
+// Joints closing a loop are kept aside for consistency checks.
+TEST(KinematicTree, FourBar) {
+  auto robot = four_bar_linkage_pure::getRobot();
+  KinematicTree tree(robot.link("l1"));
+  EXPECT_LONGS_EQUAL(4, tree.size());
+  EXPECT_LONGS_EQUAL(1, tree.loopJoints().size());
+}
+
+// Robot compiles each tree once, and recompiles after topology changes.
+TEST(KinematicTree, RobotCache) {
+  Robot robot = simple_rr::getRobot();
+  const auto root = robot.link("link_0");
+  const auto tree = robot.kinematicTree(root);
+  EXPECT(tree == robot.kinematicTree(root));
+  EXPECT_LONGS_EQUAL(3, tree->size());
+
+  robot.removeJoint(robot.joint("joint_2"));
+  const auto pruned = robot.kinematicTree(root);
+  EXPECT(tree != pruned);
+  EXPECT_LONGS_EQUAL(2, pruned->size());
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
@@ -0,0 +1,139 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testKinematicsFixedLagSmoother.cpp
+ * @brief Test fixed-lag state estimation from joint encoders and contacts.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/kinematics/KinematicsFixedLagSmoother.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <cmath>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::Point3;
+using gtsam::Pose3;
+using gtsam::Rot3;
+
+namespace example {
+const Robot robot =
+    CreateRobotFromFile(kSdfPath + std::string("spider.sdf"), "spider");
+const Pose3 wTb0(Rot3::Rz(0.3), Point3(1, 2, 0.5));
+
+std::map<std::string, double> jointAngles(size_t k) {
+  std::map<std::string, double> angles;
+  for (auto &&joint : robot.joints()) {
+    angles[joint->name()] = 0.2 * std::sin(0.1 * k + joint->id());
+  }
+  return angles;
+}
+
+// Tip of every tarsus, as in the spider walking example.
+PointOnLinks feet() {
+  PointOnLinks feet;
+  for (auto &&link : robot.links()) {
+    if (link->name().find("tarsus") == 0) {
+      feet.emplace_back(link, Point3(0, 0.19, 0));
+    }
+  }
+  return feet;
+}
+
+// Forward kinematics from the base pose at time step k.
+gtsam::Values forwardKinematics(const std::map<std::string, double> &angles,
+                                const Pose3 &wTb, size_t k) {
+  gtsam::Values known;
+  InsertPose(&known, robot.link("body")->id(), k, wTb);
+  for (auto &&joint : robot.joints()) {
+    InsertJointAngle(&known, joint->id(), k, angles.at(joint->name()));
+  }
+  return robot.forwardKinematics(known, k, "body");
+}
+}  // namespace example
+
+TEST(KinematicsFixedLagSmoother, Update) {
+  const size_t lag = 4, stride = 2;
+  KinematicsFixedLagSmoother smoother(
+      example::robot, "body", example::wTb0,
+      KinematicsFixedLagSmootherParameters(lag, stride));
+  const size_t num_links = example::robot.numLinks();
+  const size_t num_feet = example::feet().size();
+
+  for (size_t k = 0; k < 12; k++) {
+    const auto angles = example::jointAngles(k);
+    smoother.update(angles, example::feet(), 0.01);
+    EXPECT_LONGS_EQUAL(k + 1, smoother.numSteps());
+
+    // Encoders fully determine the link poses relative to the base.
+    const gtsam::Values estimate = smoother.estimate();
+    const auto fk =
+        example::forwardKinematics(angles, smoother.basePose(), k);
+    for (auto &&link : example::robot.links()) {
+      EXPECT(assert_equal(Pose(fk, link->id(), k),
+                          Pose(estimate, link->id(), k), 1e-3));
+    }
+
+    // The window is bounded by the lag and the marginalization stride.
+    EXPECT(estimate.size() <= (lag + stride - 1) * (num_links + num_feet));
+  }
+  EXPECT_LONGS_EQUAL(8, *smoother.optimizer().startTime());
+}
+
+// A single foot stays in contact while all joints move. The base has to move
+// to keep the foot in place, which the random walk alone would not predict.
+TEST(KinematicsFixedLagSmoother, Contact) {
+  const PointOnLink foot = example::feet().front();
+  KinematicsFixedLagSmoother smoother(
+      example::robot, "body", example::wTb0,
+      KinematicsFixedLagSmootherParameters(4, 2));
+
+  // Contact point with the base held at its initial pose.
+  const auto contactPoint = [&](const std::map<std::string, double> &angles) {
+    return foot.predict(
+        example::forwardKinematics(angles, example::wTb0, 0), 0);
+  };
+  const Point3 wPc = contactPoint(example::jointAngles(0));
+
+  Pose3 wTb = example::wTb0;
+  for (size_t k = 0; k < 12; k++) {
+    const auto angles = example::jointAngles(k);
+    smoother.update(angles, {foot}, 0.01);
+
+    // The base translates such that the contact point stays fixed.
+    wTb = Pose3(example::wTb0.rotation(),
+                example::wTb0.translation() + wPc - contactPoint(angles));
+    EXPECT(assert_equal(wTb, smoother.basePose(), 1e-3));
+
+    const gtsam::Values estimate = smoother.estimate();
+    const Pose3 wTc =
+        estimate.at<Pose3>(ContactPoseKey(foot.link->id(), k));
+    EXPECT(assert_equal(wPc, wTc.translation(), 1e-3));
+    EXPECT(assert_equal(wPc, foot.predict(estimate, k), 1e-3));
+  }
+
+  // The base moved well beyond the tolerance above.
+  EXPECT(gtsam::distance3(wTb.translation(), example::wTb0.translation()) >
+         5e-3);
+}
+
+TEST(KinematicsFixedLagSmoother, MissingJoint) {
+  KinematicsFixedLagSmoother smoother(example::robot, "body", example::wTb0);
+  auto angles = example::jointAngles(0);
+  angles.erase(angles.begin());
+  THROWS_EXCEPTION(smoother.update(angles, example::feet(), 0.01));
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
@@ -85,6 +85,33 @@ TEST(Interval, Interpolate) {
   EXPECT(assert_equal(Pose(result2, 0, 9), Pose(result, 0, 9)));
 }
 
+TEST(Interval, InverseKinematicsParallel) {
+  using namespace contact_goals_example;
+  const Interval interval(2, 7);
+
+  KinematicsParameters parameters;
+  parameters.method = OptimizationParameters::Method::AUGMENTED_LAGRANGIAN;
+  Kinematics serial(parameters);
+  const auto expected = serial.inverse(interval, robot, contact_goals);
+
+  // Slices are independent, so solving them concurrently is exact.
+  parameters.num_threads = 4;
+  Kinematics parallel(parameters);
+  EXPECT(assert_equal(expected,
+                      parallel.inverse(interval, robot, contact_goals)));
+
+  // Warm-started slices converge to solutions that achieve the goals.
+  parameters.warm_start_slices = true;
+  Kinematics warm_started(parameters);
+  const auto result = warm_started.inverse(interval, robot, contact_goals);
+  EXPECT_LONGS_EQUAL(expected.size(), result.size());
+  for (const ContactGoal& goal : contact_goals) {
+    for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+      EXPECT(goal.satisfied(result, k, 1e-5));
+    }
+  }
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testLeanDynamicsGraph.cpp
+ * @brief Test the dynamics graph of a legged robot with massless legs.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/dynamics/LeanDynamicsGraph.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/nonlinear/factorTesting.h>
+
+#include <cmath>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::Point3;
+using gtsam::Pose3;
+using gtsam::Values;
+using gtsam::Vector3;
+using gtsam::Vector6;
+
+namespace {
+const Robot robot =
+    CreateRobotFromFile(kUrdfPath + std::string("vision60.urdf"));
+const LeanDynamicsGraph lean(robot, "body");
+
+// Joint angles, and the resulting link poses, at time k.
+Values Kinematics(size_t k) {
+  Values values;
+  InsertPose(&values, lean.body()->id(), k, lean.body()->bMcom());
+  InsertTwist(&values, lean.body()->id(), k, gtsam::Z_6x1);
+  for (auto &&joint : robot.joints()) {
+    InsertJointAngle(&values, joint->id(), k, 0.3 * std::sin(joint->id() + 1));
+  }
+  return robot.forwardKinematics(values, k, lean.body()->name());
+}
+
+// Wrench W_b, in frame b, expressed in frame a.
+Vector6 Transform(const Pose3 &wTa, const Pose3 &wTb, const Vector6 &W_b) {
+  return wTb.between(wTa).AdjointTranspose(W_b);
+}
+}  // namespace
+
+TEST(LeanDynamicsGraph, Legs) {
+  EXPECT_LONGS_EQUAL(4, lean.legs().size());
+  const Values values = Kinematics(0);
+  const Pose3 wTb = Pose(values, lean.body()->id());
+  for (auto &&leg : lean.legs()) {
+    EXPECT_LONGS_EQUAL(3, leg.joints.size());
+    EXPECT(leg.joints.front()->child() == leg.foot);
+    EXPECT(leg.joints.back()->parent() == lean.body());
+
+    // At rest, and for the joint angles in values.
+    EXPECT(assert_equal(leg.foot->bMcom().between(lean.body()->bMcom()),
+                        leg.chain.sMb(), 1e-9));
+    LeanDynamicsGraph::LegChain::VectorN q;
+    for (int i = 0; i < 3; i++) {
+      q(i) = JointAngle(values, leg.joints[i]->id());
+    }
+    const Pose3 wTf = Pose(values, leg.foot->id());
+    EXPECT(assert_equal(wTf.between(wTb), leg.chain.poe(q), 1e-9));
+  }
+}
+
+// The graph has only body, leg wrench, joint and contact wrench variables.
+TEST(LeanDynamicsGraph, Size) {
+  const auto graph = lean.dynamicsFactors(0);
+  EXPECT_LONGS_EQUAL(1 + 2 * 4, graph.size());
+  EXPECT_LONGS_EQUAL(3 + 4 + 2 * 12, graph.keys().size());
+
+  PointOnLinks contact_points;
+  for (auto &&leg : lean.legs()) {
+    contact_points.emplace_back(leg.foot, Point3(0.14, 0, 0));
+  }
+  const auto stance = lean.dynamicsFactors(0, contact_points);
+  EXPECT_LONGS_EQUAL(1 + 3 * 4, stance.size());
+  EXPECT_LONGS_EQUAL(3 + 4 + 2 * 12 + 4, stance.keys().size());
+
+  const auto trajectory = lean.trajectoryFG(2, 0.1, Trapezoidal, {}, 2);
+  EXPECT_LONGS_EQUAL(3 * graph.size() + 2 * 12 * 2, trajectory.size());
+}
+
+// Propagate a contact force through the massless links of a leg, joint by
+// joint, and check that the lean factors agree.
+TEST(LeanDynamicsGraph, ContactWrench) {
+  const size_t k = 2;
+  Values values = Kinematics(k);
+  const auto &leg = lean.legs()[1];
+  const Point3 p(0.14, 0, 0);
+  const Vector3 force(1, -2, 30);
+  const Vector6 contact_wrench =
+      (Vector6() << p.cross(force), force).finished();
+  values.insert(ContactWrenchKey(leg.foot->id(), 0, k), contact_wrench);
+
+  // Wrench on the child link by the joint, in the child frame.
+  Vector6 wrench = -contact_wrench;
+  Vector6 body_wrench;
+  for (auto &&joint : leg.joints) {
+    InsertTorque(&values, joint->id(), k, joint->cScrewAxis().dot(wrench));
+    body_wrench = -Transform(Pose(values, joint->parent()->id(), k),
+                             Pose(values, joint->child()->id(), k), wrench);
+    wrench = -body_wrench;
+  }
+  InsertWrench(&values, lean.body()->id(), leg.joints.back()->id(), k,
+               body_wrench);
+
+  // The chain, transmission and contact moment factors of this leg are
+  // satisfied, with correct Jacobians.
+  const auto graph = lean.dynamicsFactors(k, PointOnLinks{{leg.foot, p}});
+  size_t num_checked = 0;
+  for (auto &&factor : graph) {
+    bool on_leg = true;
+    for (auto &&key : factor->keys()) on_leg &= values.exists(key);
+    if (!on_leg) continue;
+    auto noise_factor =
+        std::dynamic_pointer_cast<gtsam::NoiseModelFactor>(factor);
+    CHECK(noise_factor);
+    EXPECT_DOUBLES_EQUAL(0.0, noise_factor->error(values), 1e-9);
+    EXPECT_CORRECT_FACTOR_JACOBIANS(*noise_factor, values, 1e-7, 1e-5);
+    num_checked++;
+  }
+  EXPECT_LONGS_EQUAL(3, num_checked);
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
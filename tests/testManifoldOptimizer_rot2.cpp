@@ -260,6 +260,48 @@ TEST(ManifoldOptimizerType1_infeasible, SO2) {
   EXPECT(assert_equal(0.0, result.atDouble(x2_key), 1e-3));
 }
 
+/** Independent components are constructed and retracted concurrently, with
+ * the same result as in sequence. */
+TEST(ManifoldOptimizerType1, NumThreads) {
+  using namespace so2_scenario;
+  // Four unit circles, each a constraint-connected component.
+  NonlinearFactorGraph costs;
+  gtdynamics::EqualityConstraints constraints;
+  Values init_values;
+  auto model = noiseModel::Isotropic::Sigma(1, 1.0);
+  for (size_t i = 0; i < 4; i++) {
+    Key x_key = 2 * i + 1, y_key = 2 * i + 2;
+    Double_ dist_error = Double_(dist_square_func, Double_(x_key),
+                                 Double_(y_key)) -
+                         Double_(1.0);
+    constraints.emplace_shared<gtdynamics::DoubleExpressionEquality>(
+        dist_error, 1e-3);
+    costs.addPrior(x_key, -2.0, model);
+    costs.addPrior(y_key, 0.0, model);
+    init_values.insert(x_key, 0.8 - 0.1 * i);
+    init_values.insert(y_key, 0.6 + 0.1 * i);
+  }
+
+  LevenbergMarquardtParams nopt_params;
+  nopt_params.minModelFidelity = 0.5;
+  ManifoldOptimizerParameters mopt_params;
+  ManifoldOptimizerType1 sequential(mopt_params, nopt_params);
+  mopt_params.num_threads = 4;
+  ManifoldOptimizerType1 parallel(mopt_params, nopt_params);
+
+  auto mopt_problem =
+      parallel.initializeMoptProblem(costs, constraints, init_values);
+  EXPECT_LONGS_EQUAL(4, mopt_problem.manifold_keys_.size());
+
+  auto expected = sequential.optimize(costs, constraints, init_values);
+  auto actual = parallel.optimize(costs, constraints, init_values);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT(assert_equal(-1.0, actual.atDouble(2 * i + 1), 1e-5));
+    EXPECT(assert_equal(0.0, actual.atDouble(2 * i + 2), 1e-5));
+  }
+}
+
 /** For infeasible methods, all 3 methods shall generate the same Gauss-Newton
  * iterations. */
 TEST(ManifoldOptimizer, GaussNewtonEquality) {
@@ -21,6 +21,7 @@
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/numericalDerivative.h>
 #include <gtsam/nonlinear/Expression.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/slam/BetweenFactor.h>
 
 using namespace gtsam;
@@ -52,6 +53,96 @@ TEST(MutableLMOptimizer, optimize) {
   EXPECT(assert_equal(expected_result, result));
 }
 
+/** Repeated solves on the same structure, and on a new structure, agree with
+ * a new LM optimizer. */
+TEST(MutableLMOptimizer, reuse_structure) {
+  Key x1_key = 1;
+  Key x2_key = 2;
+  Key x3_key = 3;
+  auto noise = noiseModel::Unit::Create(6);
+  auto create_graph = [&](const Point3& p1, bool third) {
+    NonlinearFactorGraph graph;
+    graph.addPrior<Pose3>(x1_key, Pose3(Rot3::Rx(0.3), p1), noise);
+    graph.emplace_shared<BetweenFactor<Pose3>>(
+        x1_key, x2_key, Pose3(Rot3::Ry(0.2), Point3(0, 0, 1)), noise);
+    if (third) {
+      graph.emplace_shared<BetweenFactor<Pose3>>(
+          x2_key, x3_key, Pose3(Rot3(), Point3(1, 0, 0)), noise);
+    }
+    return graph;
+  };
+
+  Values values;
+  values.insert(x1_key, Pose3());
+  values.insert(x2_key, Pose3());
+
+  MutableLMOptimizer optimizer;
+  for (double x : {0.0, 1.0, 2.0}) {
+    auto graph = create_graph(Point3(x, 0, 0), false);
+    optimizer.setGraph(graph);
+    optimizer.setValues(values);
+    auto result = optimizer.optimize();
+    LevenbergMarquardtOptimizer expected(graph, values);
+    EXPECT(assert_equal(expected.optimize(), result, 1e-9));
+  }
+
+  auto graph = create_graph(Point3(1, 0, 0), true);
+  values.insert(x3_key, Pose3());
+  optimizer.setGraph(graph, Ordering::Colamd(graph));
+  optimizer.setValues(values);
+  auto result = optimizer.optimize();
+  LevenbergMarquardtOptimizer expected(graph, values);
+  EXPECT(assert_equal(expected.optimize(), result, 1e-9));
+}
+
+/** Linearizing on several threads gives the same linear graph, and thus the
+ * same iterations, as linearizing on one. */
+TEST(MutableLMOptimizer, num_threads) {
+  auto noise = noiseModel::Unit::Create(6);
+  NonlinearFactorGraph graph;
+  Values values;
+  graph.addPrior<Pose3>(0, Pose3(Rot3::Rx(0.3), Point3(1, 0, 0)), noise);
+  values.insert<Pose3>(0, Pose3());
+  for (Key k = 1; k < 20; k++) {
+    graph.emplace_shared<BetweenFactor<Pose3>>(
+        k - 1, k, Pose3(Rot3::Ry(0.1 * k), Point3(0, 0, 1)), noise);
+    values.insert<Pose3>(k, Pose3());
+  }
+
+  MutableLMOptimizer serial(graph, values);
+  MutableLMOptimizer parallel(graph, values);
+  parallel.setNumThreads(4);
+  const auto expected = serial.linearize();
+  const auto actual = parallel.linearize();
+  EXPECT_LONGS_EQUAL(expected->size(), actual->size());
+  EXPECT(assert_equal(*expected, *actual, 0.0));
+  EXPECT(assert_equal(serial.optimize(), parallel.optimize(), 0.0));
+}
+
+/** Replacing a factor in place by one on other keys, with the same number of
+ * factors and entries, does not reuse the stale structure. */
+TEST(MutableLMOptimizer, mutable_graph) {
+  auto noise = noiseModel::Unit::Create(6);
+  NonlinearFactorGraph graph;
+  graph.addPrior<Pose3>(1, Pose3(Rot3::Rx(0.3), Point3(1, 0, 0)), noise);
+  graph.emplace_shared<BetweenFactor<Pose3>>(
+      1, 2, Pose3(Rot3::Ry(0.2), Point3(0, 0, 1)), noise);
+  graph.emplace_shared<BetweenFactor<Pose3>>(
+      2, 3, Pose3(Rot3(), Point3(1, 0, 0)), noise);
+  Values values;
+  for (Key key : {1, 2, 3}) values.insert(key, Pose3());
+
+  MutableLMOptimizer optimizer(graph, values);
+  optimizer.optimize();
+
+  graph.replace(2, std::make_shared<BetweenFactor<Pose3>>(
+                       1, 3, Pose3(Rot3(), Point3(0, 1, 0)), noise));
+  optimizer.mutableGraph().replace(2, graph[2]);
+  optimizer.setValues(values);
+  LevenbergMarquardtOptimizer expected(graph, values);
+  EXPECT(assert_equal(expected.optimize(), optimizer.optimize(), 1e-6));
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
@@ -119,6 +119,31 @@ TEST(PreintegratedPointContactFactor, Jacobians) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-5);
 }
 
+/* ************************************************************************* */
+// Test jacobians when the contact frame is not aligned with the body frame.
+TEST(PreintegratedPointContactFactor, JacobiansUnaligned) {
+  size_t base_id = 0, contact_id = 1;
+  size_t t0 = 0, t1 = 1;
+
+  Pose3 wTb_i(Rot3::Rz(0.3), Point3(0.1, 0.2, 0.5)),
+      wTc_i(Rot3::Ry(0.2) * Rot3::Rx(-0.4), Point3(0.3, -0.1, 0)),
+      wTb_j(Rot3::Rz(0.4), Point3(0.2, 0.2, 0.5)),
+      wTc_j(Rot3::Ry(0.5) * Rot3::Rx(-0.1), Point3(0.32, -0.12, 0.01));
+
+  PreintegratedPointContactMeasurements pcm(wTb_i, wTc_i, 0.01, I_3x3);
+  PreintegratedPointContactFactor factor(
+      PoseKey(base_id, t0), PoseKey(contact_id, t0), PoseKey(base_id, t1),
+      PoseKey(contact_id, t1), pcm);
+
+  Values values;
+  InsertPose(&values, base_id, t0, wTb_i);
+  InsertPose(&values, base_id, t1, wTb_j);
+  InsertPose(&values, contact_id, t0, wTc_i);
+  InsertPose(&values, contact_id, t1, wTc_j);
+
+  EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-5);
+}
+
 /* ************************************************************************* */
 // Test constructor for Preintegrated Rigid Contact Factor.
 TEST(PreintegratedRigidContactMeasurements, Constructor) {
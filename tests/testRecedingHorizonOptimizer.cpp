@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testRecedingHorizonOptimizer.cpp
+ * @brief Test warm-started optimization over a sliding time window.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/optimizer/RecedingHorizonOptimizer.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <cmath>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+namespace example {
+constexpr int kHorizon = 10;
+const auto prior_model = gtsam::noiseModel::Isotropic::Sigma(1, 0.1);
+const auto smooth_model = gtsam::noiseModel::Isotropic::Sigma(1, 0.01);
+
+// Reference joint angle at absolute time step k.
+double reference(int k) { return std::sin(0.2 * k); }
+
+// Track the reference with a smooth joint angle trajectory, in the window
+// starting at absolute time step k0. Keys are relative to the window.
+NonlinearFactorGraph graph(int k0) {
+  NonlinearFactorGraph graph;
+  for (int k = 0; k <= kHorizon; k++) {
+    graph.emplace_shared<gtsam::PriorFactor<double>>(
+        JointAngleKey(0, k), reference(k0 + k), prior_model);
+    if (k > 0) {
+      graph.emplace_shared<gtsam::BetweenFactor<double>>(
+          JointAngleKey(0, k - 1), JointAngleKey(0, k), 0.0, smooth_model);
+    }
+  }
+  graph.emplace_shared<gtsam::PriorFactor<double>>(PhaseKey(0), 0.1,
+                                                   prior_model);
+  return graph;
+}
+
+Values zeros() {
+  Values values;
+  for (int k = 0; k <= kHorizon; k++) InsertJointAngle(&values, 0, k, 0.0);
+  values.insert(PhaseKey(0), 0.0);
+  return values;
+}
+}  // namespace example
+
+TEST(RecedingHorizonOptimizer, ShiftedValues) {
+  RecedingHorizonOptimizer optimizer(OptimizationParameters(), {PhaseKey(0)});
+  THROWS_EXCEPTION(optimizer.shiftedValues(example::graph(1), 1));
+
+  const Values solution = optimizer.solve(example::graph(0), example::zeros());
+
+  const Values shifted = optimizer.shiftedValues(example::graph(2), 2);
+  EXPECT_LONGS_EQUAL(example::kHorizon + 2, shifted.size());
+  for (int k = 0; k <= example::kHorizon - 2; k++) {
+    EXPECT_DOUBLES_EQUAL(JointAngle(solution, 0, k + 2),
+                         JointAngle(shifted, 0, k), 1e-9);
+  }
+  for (int k = example::kHorizon - 1; k <= example::kHorizon; k++) {
+    EXPECT_DOUBLES_EQUAL(JointAngle(solution, 0, example::kHorizon),
+                         JointAngle(shifted, 0, k), 1e-9);
+  }
+  EXPECT_DOUBLES_EQUAL(solution.at<double>(PhaseKey(0)),
+                       shifted.at<double>(PhaseKey(0)), 1e-9);
+
+  // Variables that are new in the shifted window come from the fallback.
+  NonlinearFactorGraph extended = example::graph(2);
+  extended.emplace_shared<gtsam::PriorFactor<double>>(JointVelKey(0, 0), 1.0,
+                                                      example::prior_model);
+  THROWS_EXCEPTION(optimizer.shiftedValues(extended, 2));
+  Values fallback;
+  InsertJointVel(&fallback, 0, 0, 0.5);
+  EXPECT_DOUBLES_EQUAL(
+      0.5, JointVel(optimizer.shiftedValues(extended, 2, fallback), 0, 0), 0);
+
+  THROWS_EXCEPTION(
+      optimizer.shiftedValues(example::graph(0), example::kHorizon + 1));
+}
+
+TEST(RecedingHorizonOptimizer, WarmStart) {
+  RecedingHorizonOptimizer optimizer(OptimizationParameters(), {PhaseKey(0)});
+  optimizer.solve(example::graph(0), example::zeros());
+  CHECK(optimizer.lambda());
+
+  for (int k0 = 1; k0 <= 3; k0++) {
+    const auto graph = example::graph(k0);
+    const double warm_error = graph.error(optimizer.shiftedValues(graph, 1));
+    const Values &solution = optimizer.shiftAndSolve(graph);
+
+    // Same solution as a cold start, from a much better initial guess.
+    RecedingHorizonOptimizer cold(OptimizationParameters(), {PhaseKey(0)});
+    EXPECT(assert_equal(cold.solve(graph, example::zeros()), solution, 1e-4));
+    EXPECT(warm_error < graph.error(example::zeros()));
+  }
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
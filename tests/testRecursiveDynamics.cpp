@@ -0,0 +1,196 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testRecursiveDynamics.cpp
+ * @brief Test recursive dynamics algorithms against the linear factor graph.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/dynamics/RecursiveDynamics.h>
+#include <gtdynamics/universal_robot/Robot.h>
+#include <gtdynamics/universal_robot/RobotModels.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/nonlinear/Values.h>
+
+using namespace gtdynamics;
+
+using gtsam::assert_equal;
+using gtsam::Values;
+using gtsam::Vector6;
+
+// Check that the recursive and the factor graph solutions agree.
+bool assert_same_fd(const Robot& robot, int t, const Values& expected,
+                    const Values& actual, double tol = 1e-6) {
+  bool ok = true;
+  for (auto&& joint : robot.joints()) {
+    int j = joint->id();
+    int i1 = joint->parent()->id();
+    int i2 = joint->child()->id();
+    ok &= assert_equal(JointAccel(expected, j, t), JointAccel(actual, j, t),
+                       tol);
+    ok &= assert_equal(Wrench(expected, i1, j, t), Wrench(actual, i1, j, t),
+                       tol);
+    ok &= assert_equal(Wrench(expected, i2, j, t), Wrench(actual, i2, j, t),
+                       tol);
+  }
+  for (auto&& link : robot.links()) {
+    int i = link->id();
+    ok &= assert_equal(TwistAccel(expected, i, t), TwistAccel(actual, i, t),
+                       tol);
+  }
+  return ok;
+}
+
+// Check that torques and wrenches of an inverse dynamics solution agree.
+bool assert_same_id(const Robot& robot, int t, const Values& expected,
+                    const Values& actual, double tol = 1e-6) {
+  bool ok = true;
+  for (auto&& joint : robot.joints()) {
+    int j = joint->id();
+    int i1 = joint->parent()->id();
+    int i2 = joint->child()->id();
+    ok &= assert_equal(Torque(expected, j, t), Torque(actual, j, t), tol);
+    ok &= assert_equal(Wrench(expected, i1, j, t), Wrench(actual, i1, j, t),
+                       tol);
+    ok &= assert_equal(Wrench(expected, i2, j, t), Wrench(actual, i2, j, t),
+                       tol);
+  }
+  return ok;
+}
+
+// Known values for inverse dynamics: kinematics and accelerations from fd.
+Values id_inputs(const Robot& robot, int t, const Values& known_values,
+                 const Values& fd_result) {
+  Values values = known_values;
+  for (auto&& joint : robot.joints()) {
+    int j = joint->id();
+    values.erase(TorqueKey(j, t));
+    InsertJointAccel(&values, j, t, JointAccel(fd_result, j, t));
+  }
+  return values;
+}
+
+// Floating two-link robot, same setup as in testDynamicsGraph.
+TEST(RecursiveDynamics, simple_urdf_eq_mass) {
+  auto robot = simple_urdf_eq_mass::getRobot();
+  auto l1 = robot.link("l1");
+  auto j = robot.joint("j1")->id();
+  int t = 777;
+
+  Values values;
+  InsertPose(&values, l1->id(), t, l1->bMcom());
+  InsertTwist(&values, l1->id(), t, gtsam::Z_6x1);
+  Values known_values = robot.forwardKinematics(values, t, std::string("l1"));
+  InsertTorque(&known_values, j, t, 1.0);
+
+  RecursiveDynamics solver(simple_urdf_eq_mass::gravity);
+  Values actual = solver.solveFD(robot, t, known_values);
+  EXPECT(assert_equal(4.0, JointAccel(actual, j, t), 1e-9));
+
+  DynamicsGraph graph_builder(simple_urdf_eq_mass::gravity,
+                              simple_urdf_eq_mass::planar_axis);
+  Values expected = graph_builder.linearSolveFD(robot, t, known_values);
+  EXPECT(assert_same_fd(robot, t, expected, actual));
+}
+
+// Fixed-base arm with gravity and non-zero joint velocities.
+TEST(RecursiveDynamics, simple_rr) {
+  auto robot = simple_rr::getRobot().fixLink("link_0");
+  int t = 3;
+  gtsam::Vector3 gravity(0, 0, -9.8);
+
+  Values values;
+  for (auto&& joint : robot.joints()) {
+    int j = joint->id();
+    InsertJointAngle(&values, j, t, 0.3 * (j + 1));
+    InsertJointVel(&values, j, t, -0.7 * (j + 1));
+  }
+  Values known_values = robot.forwardKinematics(values, t);
+  for (auto&& joint : robot.joints()) {
+    InsertTorque(&known_values, joint->id(), t, 0.5 - joint->id());
+  }
+
+  Values expected = DynamicsGraph(gravity).linearSolveFD(robot, t, known_values);
+  Values actual = RecursiveDynamics(gravity).solveFD(robot, t, known_values);
+  EXPECT(assert_same_fd(robot, t, expected, actual));
+
+  // Inverse dynamics recovers the torques, and agrees with the linear graph.
+  Values accels = id_inputs(robot, t, known_values, actual);
+  DynamicsGraph graph_builder(gravity);
+  Values id_result = RecursiveDynamics(gravity).solveID(robot, t, accels);
+  EXPECT(assert_same_id(robot, t, actual, id_result));
+
+  auto graph = graph_builder.linearDynamicsGraph(robot, t, accels);
+  graph.push_back(DynamicsGraph::linearIDPriors(robot, t, accels));
+  gtsam::VectorValues results = graph.optimize();
+  for (auto&& joint : robot.joints()) {
+    int j = joint->id();
+    EXPECT(assert_equal(Torque(results, j, t)[0], Torque(id_result, j, t),
+                        1e-6));
+  }
+  EXPECT(assert_same_id(robot, t, id_result,
+                        graph_builder.linearSolveID(robot, t, accels)));
+}
+
+// Floating-base legged robot, with a moving body.
+TEST(RecursiveDynamics, spider) {
+  auto robot =
+      CreateRobotFromFile(kSdfPath + std::string("spider.sdf"), "spider");
+  auto body = robot.link("body");
+  int t = 0;
+  gtsam::Vector3 gravity(0, 0, -9.8);
+
+  Values values;
+  InsertPose(&values, body->id(), t, body->bMcom());
+  InsertTwist(&values, body->id(), t,
+              (Vector6() << 0.1, -0.2, 0.3, 0.5, 0.0, -0.4).finished());
+  for (auto&& joint : robot.joints()) {
+    int j = joint->id();
+    InsertJointAngle(&values, j, t, 0.1 * std::sin(j));
+    InsertJointVel(&values, j, t, 0.2 * std::cos(j));
+  }
+  Values known_values = robot.forwardKinematics(values, t, body->name());
+  for (auto&& joint : robot.joints()) {
+    InsertTorque(&known_values, joint->id(), t, std::sin(3.0 * joint->id()));
+  }
+
+  Values expected = DynamicsGraph(gravity).linearSolveFD(robot, t, known_values);
+  Values actual = RecursiveDynamics(gravity).solveFD(robot, t, known_values);
+  EXPECT(assert_same_fd(robot, t, expected, actual, 1e-5));
+
+  // Inverse dynamics with a floating base recovers the torques and the body
+  // acceleration.
+  Values accels = id_inputs(robot, t, known_values, actual);
+  Values id_result = RecursiveDynamics(gravity).solveID(robot, t, accels);
+  EXPECT(assert_same_id(robot, t, actual, id_result, 1e-5));
+  EXPECT(assert_equal(TwistAccel(actual, body->id(), t),
+                      TwistAccel(id_result, body->id(), t), 1e-5));
+}
+
+// Closed chains are detected and rejected.
+TEST(RecursiveDynamics, four_bar_linkage) {
+  auto robot = four_bar_linkage_pure::getRobot();
+  EXPECT(!RecursiveDynamics::IsTree(robot));
+  EXPECT(RecursiveDynamics::IsTree(simple_rr::getRobot()));
+
+  Values known_values;
+  THROWS_EXCEPTION(RecursiveDynamics().solveFD(robot, 0, known_values));
+  THROWS_EXCEPTION(RecursiveDynamics().solveID(robot, 0, known_values));
+  EXPECT(!RecursiveDynamics().trySolveID(robot, 0, known_values));
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
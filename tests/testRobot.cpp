@@ -282,6 +282,39 @@ TEST(ForwardKinematics, A1) {
       Pose(fk_results, 20, 0), 1e-6));
 }
 
+// Batched forward kinematics over a trajectory matches stepwise calls.
+TEST(ForwardKinematics, Trajectory) {
+  Robot robot =
+      CreateRobotFromFile(kSdfPath + std::string("spider.sdf"), "spider");
+  const auto body = robot.link("body");
+  const Interval interval(3, 22);
+
+  Values values;
+  for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+    InsertPose(&values, body->id(), k,
+               Pose3(Rot3::Rz(0.01 * k), Point3(0.02 * k, 0, 0.5)));
+    InsertTwist(&values, body->id(), k,
+                (Vector6() << 0, 0, 0.01, 0.02, 0, 0).finished());
+    for (auto&& joint : robot.joints()) {
+      // Leave some joint velocities out, they default to zero.
+      const int j = joint->id();
+      InsertJointAngle(&values, j, k, 0.1 * std::sin(k + j));
+      if (j % 3) {
+        InsertJointVel(&values, j, k, 0.1 * std::cos(k));
+      }
+    }
+  }
+
+  Values expected = values;
+  for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+    expected = robot.forwardKinematics(expected, k, body->name());
+  }
+  EXPECT(assert_equal(expected,
+                      robot.forwardKinematics(values, interval, body->name())));
+  EXPECT(assert_equal(
+      expected, robot.forwardKinematics(values, interval, body->name(), 4)));
+}
+
 TEST(Robot, Equality) {
   Robot robot1 = CreateRobotFromFile(
       kSdfPath + std::string("test/four_bar_linkage_pure.sdf"));
@@ -52,6 +52,30 @@ TEST(Simulate, simple_urdf) {
   EXPECT(assert_equal(expected_qAccel, JointAccel(results, 0)));
 }
 
+TEST(Simulate, simple_urdf_articulated_body) {
+  using gtsam::assert_equal;
+  using simple_urdf::gravity, simple_urdf::planar_axis;
+  auto robot = simple_urdf::getRobot();
+  gtsam::Values initial_values, torques;
+  InsertTorque(&torques, 0, 1.0);
+
+  // The articulated-body solver has no planar constraints.
+  THROWS_EXCEPTION(Simulator(robot, initial_values, gravity, planar_axis,
+                             ArticulatedBodySolver));
+  Simulator graph_simulator(robot, initial_values, gravity);
+  Simulator aba_simulator(robot, initial_values, gravity, {},
+                          ArticulatedBodySolver);
+
+  double dt = 0.1;
+  std::vector<gtsam::Values> torques_seq(10, torques);
+  auto expected = graph_simulator.simulate(torques_seq, dt);
+  auto actual = aba_simulator.simulate(torques_seq, dt);
+
+  EXPECT(assert_equal(JointAngle(expected, 0), JointAngle(actual, 0), 1e-9));
+  EXPECT(assert_equal(JointVel(expected, 0), JointVel(actual, 0), 1e-9));
+  EXPECT(assert_equal(JointAccel(expected, 0), JointAccel(actual, 0), 1e-9));
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
@@ -0,0 +1,159 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2020, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testSliceTemplate.cpp
+ * @brief Test instantiating time slices from a template slice.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/dynamics/DynamicsGraph.h>
+#include <gtdynamics/factors/RemappedFactor.h>
+#include <gtdynamics/kinematics/Kinematics.h>
+#include <gtdynamics/statics/Statics.h>
+#include <gtdynamics/universal_robot/sdf.h>
+#include <gtdynamics/utils/Initializer.h>
+#include <gtdynamics/utils/SliceTemplate.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/nonlinear/expressions.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+namespace {
+const Robot robot =
+    CreateRobotFromFile(kSdfPath + std::string("spider.sdf"), "spider");
+const gtsam::Vector3 gravity(0, 0, -9.8);
+
+// Check that two graphs have the same keys, errors, and linearization.
+bool assert_same_graph(const NonlinearFactorGraph& expected,
+                       const NonlinearFactorGraph& actual,
+                       const Values& values) {
+  if (expected.size() != actual.size()) return false;
+  for (size_t i = 0; i < expected.size(); i++) {
+    if (expected[i]->keys() != actual[i]->keys()) return false;
+  }
+  return assert_equal(expected.error(values), actual.error(values), 1e-9) &&
+         assert_equal(*expected.linearize(values), *actual.linearize(values),
+                      1e-9);
+}
+}  // namespace
+
+TEST(SliceTemplate, ShiftTime) {
+  EXPECT_LONGS_EQUAL(PoseKey(3, 12), ShiftTime(PoseKey(3, 5), 7));
+  EXPECT_LONGS_EQUAL(WrenchKey(2, 4, 0), ShiftTime(WrenchKey(2, 4, 9), -9));
+  THROWS_EXCEPTION(ShiftTime(JointAngleKey(1, 2), -3));
+}
+
+TEST(SliceTemplate, Kinematics) {
+  Kinematics kinematics;
+  SliceTemplate slice_template(kinematics.graph(Slice(0), robot), Slice(0));
+
+  const size_t k = 5;
+  Values values = Initializer().ZeroValues(robot, k, 0.1);
+  EXPECT(assert_same_graph(kinematics.graph(Slice(k), robot),
+                           slice_template.instantiate(Slice(k)), values));
+}
+
+TEST(SliceTemplate, Statics) {
+  Statics statics(StaticsParameters(1e-5, gravity));
+  SliceTemplate slice_template(statics.graph(Slice(3), robot), Slice(3));
+
+  // Shifting backwards works as well.
+  const size_t k = 1;
+  Values values = Initializer().ZeroValues(robot, k, 0.1);
+  EXPECT(assert_same_graph(statics.graph(Slice(k), robot),
+                           slice_template.instantiate(Slice(k)), values));
+}
+
+TEST(SliceTemplate, Dynamics) {
+  DynamicsGraph graph_builder(gravity);
+  SliceTemplate slice_template(graph_builder.dynamicsFactorGraph(robot, 0),
+                               Slice(0));
+  EXPECT(slice_template.instantiate(Slice(0)).size() ==
+         slice_template.graph().size());
+
+  const Interval interval(8, 9);
+  Values values;
+  NonlinearFactorGraph expected;
+  for (size_t k = interval.k_start; k <= interval.k_end; k++) {
+    values.insert(Initializer().ZeroValues(robot, k, 0.1));
+    expected.add(graph_builder.dynamicsFactorGraph(robot, k));
+  }
+  EXPECT(assert_same_graph(expected, slice_template.instantiate(interval),
+                           values));
+}
+
+// Known factor classes are re-keyed, all others share the original.
+TEST(SliceTemplate, Remapped) {
+  const auto model = gtsam::noiseModel::Unit::Create(1);
+  const gtsam::Double_ q0(JointAngleKey(0, 2)), q1(JointAngleKey(1, 2));
+  NonlinearFactorGraph graph;
+  graph.addExpressionFactor(model, 0.5, q0 - q1);
+  graph.emplace_shared<gtsam::BetweenFactor<double>>(
+      JointAngleKey(0, 2), JointAngleKey(1, 2), 0.5, model);
+  graph.emplace_shared<gtsam::BetweenFactor<gtsam::Vector1>>(
+      JointVelKey(0, 2), JointVelKey(1, 2), gtsam::Vector1(0.5), model);
+  SliceTemplate slice_template(graph, Slice(2));
+
+  // Instantiating from an instantiated slice shares the original factor.
+  SliceTemplate second_template(slice_template.instantiate(Slice(4)),
+                                Slice(4));
+  const auto slice6 = second_template.instantiate(Slice(6));
+  auto remapped = std::dynamic_pointer_cast<RemappedFactor>(slice6[0]);
+  CHECK(remapped);
+  EXPECT(remapped->baseFactor() == graph[0]);
+  auto between =
+      std::dynamic_pointer_cast<gtsam::BetweenFactor<double>>(slice6[1]);
+  CHECK(between);
+  EXPECT(between->keys() == remapped->keys());
+  auto unknown = std::dynamic_pointer_cast<RemappedFactor>(slice6[2]);
+  CHECK(unknown);
+  EXPECT(unknown->baseFactor() == graph[2]);
+
+  NonlinearFactorGraph expected;
+  expected.addExpressionFactor(model, 0.5,
+                               gtsam::Double_(JointAngleKey(0, 6)) -
+                                   gtsam::Double_(JointAngleKey(1, 6)));
+  expected.push_back(between);
+  expected.emplace_shared<gtsam::BetweenFactor<gtsam::Vector1>>(
+      JointVelKey(0, 6), JointVelKey(1, 6), gtsam::Vector1(0.5), model);
+
+  // Evaluate twice, as the remapped factors reuse their values.
+  Values values;
+  InsertJointAngle(&values, 0, 6, 1.0);
+  InsertJointAngle(&values, 1, 6, 0.2);
+  values.insert(JointVelKey(0, 6), gtsam::Vector1(0.3));
+  values.insert(JointVelKey(1, 6), gtsam::Vector1(-0.4));
+  EXPECT(assert_same_graph(expected, slice6, values));
+  values.update<double>(JointAngleKey(1, 6), -0.7);
+  values.update<gtsam::Vector1>(JointVelKey(0, 6), gtsam::Vector1(2.0));
+  EXPECT(assert_same_graph(expected, slice6, values));
+}
+
+// Factors that are not noise-model factors cannot be remapped.
+TEST(SliceTemplate, Unsupported) {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<gtsam::LinearContainerFactor>(
+      gtsam::JacobianFactor(JointAngleKey(0, 2), gtsam::I_1x1,
+                            gtsam::Vector1(0.5)));
+  SliceTemplate slice_template(graph, Slice(2));
+  THROWS_EXCEPTION(slice_template.instantiate(Slice(3)));
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
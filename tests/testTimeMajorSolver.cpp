@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+ * GTDynamics Copyright 2021, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  testTimeMajorSolver.cpp
+ * @brief Test the time-major ordering and solver for trajectory graphs.
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtdynamics/optimizer/MutableLMOptimizer.h>
+#include <gtdynamics/optimizer/TimeMajorSolver.h>
+#include <gtdynamics/utils/values.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <cmath>
+
+using namespace gtdynamics;
+using gtsam::assert_equal;
+using gtsam::NonlinearFactorGraph;
+using gtsam::Values;
+
+namespace {
+const size_t kNumSteps = 10;
+const auto kModel = gtsam::noiseModel::Isotropic::Sigma(1, 0.1);
+
+// Two joints over time, coupled within and across time steps, and the
+// duration of a single phase, coupled with all time steps.
+NonlinearFactorGraph TrajectoryGraph() {
+  NonlinearFactorGraph graph;
+  graph.addPrior(JointAngleKey(0, 0), 0.0, kModel);
+  graph.addPrior(JointAngleKey(1, 0), 1.0, kModel);
+  graph.addPrior(PhaseKey(0), 0.1, kModel);
+  for (size_t k = 0; k <= kNumSteps; k++) {
+    graph.emplace_shared<gtsam::BetweenFactor<double>>(
+        JointAngleKey(0, k), JointAngleKey(1, k), 1.0, kModel);
+    if (k == kNumSteps) continue;
+    for (int j = 0; j < 2; j++) {
+      graph.emplace_shared<gtsam::BetweenFactor<double>>(
+          JointAngleKey(j, k), JointAngleKey(j, k + 1), 0.1 * k, kModel);
+    }
+    graph.emplace_shared<gtsam::BetweenFactor<double>>(
+        PhaseKey(0), JointAngleKey(0, k), 0.2, kModel);
+  }
+  return graph;
+}
+
+Values TrajectoryValues() {
+  Values values;
+  values.insert(PhaseKey(0), 0.0);
+  for (size_t k = 0; k <= kNumSteps; k++) {
+    for (int j = 0; j < 2; j++) {
+      values.insert(JointAngleKey(j, k), std::sin(j + k));
+    }
+  }
+  return values;
+}
+}  // namespace
+
+TEST(TimeMajorSolver, Ordering) {
+  const auto graph = TrajectoryGraph();
+  const auto ordering = TimeMajorOrdering(graph);
+  EXPECT_LONGS_EQUAL(graph.keys().size(), ordering.size());
+  for (size_t i = 1; i < ordering.size(); i++) {
+    EXPECT(KeyStep(ordering[i - 1]) <= KeyStep(ordering[i]));
+  }
+
+  // The phase duration, which couples all time steps, is eliminated last.
+  EXPECT(IsPhaseKey(PhaseKey(0)));
+  EXPECT(!IsPhaseKey(JointAngleKey(0, 0)));
+  EXPECT(ordering.back() == PhaseKey(0));
+
+  const auto linear = graph.linearize(TrajectoryValues());
+  EXPECT(assert_equal(ordering, TimeMajorOrdering(*linear)));
+}
+
+TEST(TimeMajorSolver, Solve) {
+  const auto linear = TrajectoryGraph().linearize(TrajectoryValues());
+  const gtsam::VectorValues expected = linear->optimize();
+  EXPECT(assert_equal(expected, TimeMajorSolve(*linear), 1e-9));
+  EXPECT(assert_equal(expected,
+                      TimeMajorSolve(*linear, gtsam::EliminateQR), 1e-9));
+}
+
+// As the linear solver of LM, the solution is the same.
+TEST(TimeMajorSolver, MutableLMOptimizer) {
+  const auto graph = TrajectoryGraph();
+  const auto values = TrajectoryValues();
+
+  gtsam::MutableLMOptimizer optimizer(graph, values);
+  optimizer.setLinearSolver(
+      [](const gtsam::GaussianFactorGraph &damped) {
+        return TimeMajorSolve(damped);
+      });
+  const Values actual = optimizer.optimize();
+
+  gtsam::LevenbergMarquardtOptimizer expected(graph, values);
+  EXPECT(assert_equal(expected.optimize(), actual, 1e-6));
+}
+
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
@@ -20,6 +20,9 @@
 #include <gtdynamics/utils/Trajectory.h>
 #include <gtdynamics/utils/WalkCycle.h>
 
+#include <algorithm>
+#include <map>
+
 #include "walkCycleExample.h"
 
 using namespace gtsam;
@@ -121,6 +124,60 @@ TEST(Trajectory, error) {
   EXPECT_LONGS_EQUAL(260, boundary_conditions.size());
 }
 
+// Phase interiors are eliminated before the transition that separates them.
+TEST(Trajectory, nestedDissectionOrdering) {
+  using namespace walk_cycle_example;
+  const Trajectory trajectory(walk_cycle, 3);
+  const auto graph_builder = DynamicsGraph(OptimizerSetting(1e-5),
+                                           gtsam::Vector3(0, 0, -9.8));
+  const auto graph = trajectory.multiPhaseFactorGraph(
+      robot, graph_builder, CollocationScheme::Euler, 1.0);
+
+  const Ordering ordering = trajectory.nestedDissectionOrdering(graph);
+  const KeySet keys = graph.keys();
+  EXPECT_LONGS_EQUAL(keys.size(), ordering.size());
+  EXPECT(KeySet(ordering.begin(), ordering.end()) == keys);
+
+  std::map<Key, size_t> position;
+  for (size_t i = 0; i < ordering.size(); i++) position[ordering[i]] = i;
+
+  // Earliest separator and latest interior position of every phase.
+  const size_t num_phases = trajectory.numPhases();
+  vector<size_t> first_separator(num_phases, ordering.size()),
+      last_interior(num_phases, 0);
+  KeySet phase_keys;
+  for (size_t p = 0; p < num_phases; p++) {
+    last_interior[p] = position.at(PhaseKey(p));
+    phase_keys.insert(PhaseKey(p));
+  }
+  for (Key key : keys) {
+    if (phase_keys.count(key)) continue;
+    const int k = DynamicsSymbol(key).time();
+    for (size_t p = 0; p < num_phases; p++) {
+      if (k < trajectory.getStartTimeStep(p) ||
+          k > trajectory.getEndTimeStep(p)) {
+        continue;
+      }
+      if (k == trajectory.getEndTimeStep(p) && p + 1 < num_phases) {
+        first_separator[p] = std::min(first_separator[p], position.at(key));
+      } else {
+        last_interior[p] = std::max(last_interior[p], position.at(key));
+      }
+      break;
+    }
+  }
+  for (size_t p = 0; p + 1 < num_phases; p++) {
+    EXPECT(last_interior[p] < first_separator[p]);
+    EXPECT(last_interior[p + 1] < first_separator[p]);
+  }
+
+  // The helper sets the ordering of the LM parameters.
+  gtsam::LevenbergMarquardtParams params;
+  trajectory.setNestedDissectionOrdering(graph, &params);
+  CHECK(params.ordering);
+  EXPECT(assert_equal(ordering, *params.ordering));
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
@@ -121,6 +121,76 @@ TEST(TspaceBasis, connected_poses) {
   }
 }
 
+/** Matrix basis caches its pseudo-inverse, and is reused at equal values. */
+TEST(TspaceBasis, MatrixBasisCache) {
+  gtdynamics::EqualityConstraints constraints;
+  auto noise = noiseModel::Unit::Create(6);
+  constraints.emplace_shared<gtdynamics::FactorZeroErrorConstraint>(
+      std::make_shared<BetweenFactor<Pose3>>(
+          1, 2, Pose3(Rot3::Rx(0.3), Point3(0, 0, 1)), noise));
+  auto component = std::make_shared<ConnectedComponent>(constraints);
+
+  Values values;
+  values.insert(1, Pose3(Rot3::Ry(0.2), Point3(1, 0, 0)));
+  values.insert(2, values.at<Pose3>(1) * Pose3(Rot3::Rx(0.3), Point3(0, 0, 1)));
+  auto params = std::make_shared<TspaceBasisParams>();
+  MatrixBasis basis(params, component, values);
+  EXPECT(basis.isConstructedAt(values));
+  Matrix expected_pinv =
+      basis.matrix().completeOrthogonalDecomposition().pseudoInverse();
+  EXPECT(assert_equal(expected_pinv, basis.pseudoInverse(), 1e-9));
+
+  // Local coordinates invert the tangent vector.
+  Vector xi = (Vector(6) << 0.1, -0.2, 0.3, 0.4, 0.5, -0.6).finished();
+  Values other = values.retract(basis.computeTangentVector(xi));
+  EXPECT(assert_equal(xi, basis.localCoordinates(values, other), 1e-9));
+
+  // The basis is reused at the same values, and recomputed otherwise.
+  auto same = std::dynamic_pointer_cast<MatrixBasis>(
+      basis.createWithNewValues(component, values));
+  EXPECT(same->isConstructedAt(values));
+  EXPECT(assert_equal(basis.matrix(), same->matrix()));
+  auto moved = std::dynamic_pointer_cast<MatrixBasis>(
+      basis.createWithNewValues(component, other));
+  EXPECT(moved->isConstructedAt(other));
+  EXPECT(!moved->isConstructedAt(values));
+  MatrixBasis expected(params, component, other);
+  EXPECT(assert_equal(expected.matrix(), moved->matrix(), 1e-9));
+}
+
+/** Sparse basis spans the same kernel as the dense one. */
+TEST(TspaceBasis, SparseMatrixBasis) {
+  gtdynamics::EqualityConstraints constraints;
+  auto noise = noiseModel::Unit::Create(6);
+  for (Key key = 1; key < 4; key++) {
+    constraints.emplace_shared<gtdynamics::FactorZeroErrorConstraint>(
+        std::make_shared<BetweenFactor<Pose3>>(
+            key, key + 1, Pose3(Rot3::Rx(0.3), Point3(0, 0, 1)), noise));
+  }
+  auto component = std::make_shared<ConnectedComponent>(constraints);
+
+  Values values;
+  values.insert(1, Pose3(Rot3::Ry(0.2), Point3(1, 0, 0)));
+  for (Key key = 2; key < 5; key++) {
+    values.insert(key, values.at<Pose3>(key - 1) *
+                           Pose3(Rot3::Rx(0.3), Point3(0, 0, 1)));
+  }
+  auto params = std::make_shared<TspaceBasisParams>();
+  SparseMatrixBasis basis(params, component, values);
+  MatrixBasis dense_basis(params, component, values);
+  EXPECT_LONGS_EQUAL(6, basis.dim());
+
+  // Same column space as the dense kernel.
+  Matrix both(dense_basis.matrix().rows(), 12);
+  both << dense_basis.matrix(), Matrix(basis.matrix());
+  EXPECT_LONGS_EQUAL(6, Eigen::FullPivLU<Matrix>(both).rank());
+
+  // Local coordinates invert the tangent vector.
+  Vector xi = (Vector(6) << 0.1, -0.2, 0.3, 0.4, 0.5, -0.6).finished();
+  Values other = values.retract(basis.computeTangentVector(xi));
+  EXPECT(assert_equal(xi, basis.localCoordinates(values, other), 1e-9));
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
@@ -34,6 +34,27 @@ TEST(Values, at) {
   CHECK_EXCEPTION(TwistAccel(values, 7), KeyDoesNotExist);
 }
 
+TEST(Values, ShiftValues) {
+  gtsam::Values values;
+  InsertJointAngle(&values, 2, 0, 0.0);
+  InsertJointAngle(&values, 2, 1, 1.0);
+  InsertPose(&values, 3, 2, gtsam::Pose3());
+  values.insert(PhaseKey(1), 0.1);
+
+  gtsam::Values expected;
+  InsertJointAngle(&expected, 2, 0, 1.0);
+  InsertPose(&expected, 3, 1, gtsam::Pose3());
+  expected.insert(PhaseKey(1), 0.1);
+  EXPECT(assert_equal(expected, ShiftValues(values, -1, {PhaseKey(1)})));
+
+  gtsam::Values forward;
+  InsertJointAngle(&forward, 2, 3, 0.0);
+  InsertJointAngle(&forward, 2, 4, 1.0);
+  InsertPose(&forward, 3, 5, gtsam::Pose3());
+  forward.insert(PhaseKey(4), 0.1);  // not static, so shifted as well
+  EXPECT(assert_equal(forward, ShiftValues(values, 3)));
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);
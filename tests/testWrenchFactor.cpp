@@ -19,6 +19,7 @@
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/numericalDerivative.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/nonlinear/GaussNewtonOptimizer.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
@@ -115,6 +116,38 @@ TEST(WrenchFactor, NonzeroTwistCase) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(*factor, x, diffDelta, tol);
 }
 
+// Closed-form Jacobians agree with the expression of Link::wrenchConstraint.
+TEST(WrenchFactor, MatchesExpression) {
+  int id = 0;
+  const std::vector<Key> wrench_keys{WrenchKey(id, 1), WrenchKey(id, 2)};
+  auto factor = WrenchFactor(example::cost_model, example::link, wrench_keys,
+                             0, example::gravity);
+  ExpressionFactor<Vector6> expression_factor(
+      example::cost_model, Z_6x1,
+      example::link->wrenchConstraint(wrench_keys, 0, example::gravity));
+
+  Values x;
+  InsertTwist(&x, id, (Vector(6) << 0.1, -0.4, 1, 0.3, 1, -2).finished());
+  InsertTwistAccel(&x, id, (Vector(6) << 1, 0, 0.5, 0, -1, 2).finished());
+  InsertWrench(&x, id, 1, (Vector(6) << 1, 2, 3, 4, 5, 6).finished());
+  InsertWrench(&x, id, 2, (Vector(6) << -3, 0, 1, 0.5, 0, -2).finished());
+  InsertPose(&x, id, Pose3(Rot3::Ypr(0.3, -0.2, 1.1), Point3(1, 0, 2)));
+
+  std::vector<Matrix> H(factor->size()), H_expected(expression_factor.size());
+  EXPECT(assert_equal(expression_factor.unwhitenedError(x, &H_expected),
+                      factor->unwhitenedError(x, &H), 1e-9));
+
+  // The key order differs, so compare the Jacobians key by key.
+  EXPECT_LONGS_EQUAL(expression_factor.size(), factor->size());
+  for (size_t i = 0; i < factor->size(); i++) {
+    const auto it = expression_factor.find(factor->keys()[i]);
+    CHECK(it != expression_factor.end());
+    EXPECT(assert_equal(H_expected[it - expression_factor.begin()], H[i],
+                        1e-9));
+  }
+  EXPECT_CORRECT_FACTOR_JACOBIANS(*factor, x, diffDelta, tol);
+}
+
 int main() {
   TestResult tr;
   return TestRegistry::runAllTests(tr);